@@ -0,0 +1,624 @@
+/// \file main.cpp
+/// \brief A benchmark program for uintx_t.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <chrono>
+#include <functional>
+#include <new>
+#include <random>
+#include <string>
+#include <utility>
+
+#include "uintx_t.h"
+#include "uintx_math.h"
+#include "uintx_tune.h"
+#include "uintx_divisor.h"
+#include "modx_t.h"
+
+std::mt19937 g_cPRNG; ///< Pseudo-random number generator.
+
+const double MIN_TIME = 0.25; ///< Minimum time to spend on each measurement, in seconds.
+
+uint64_t g_nAllocCount = 0; ///< Number of arrays allocated.
+uint64_t g_nAllocBytes = 0; ///< Number of bytes allocated for arrays.
+
+//////////////////////////////////////////////////////////////////////////////
+// Allocation counting
+
+/// \brief Array allocation.
+///
+/// Replacement for the global array new operator, which uintx_t uses for
+/// its storage, that counts the number of arrays and bytes allocated.
+///
+/// \param n Number of bytes.
+/// \return Pointer to the allocated memory.
+
+void* operator new[](size_t n){
+  g_nAllocCount++;
+  g_nAllocBytes += n;
+
+  void* p = malloc(n > 0? n: 1);
+  if(p == nullptr)throw std::bad_alloc();
+
+  return p;
+} //operator new[]
+
+/// \brief Array deallocation.
+///
+/// Replacement for the global array delete operator to match operator new[].
+///
+/// \param p Pointer to memory allocated by operator new[].
+
+void operator delete[](void* p) noexcept{
+  free(p);
+} //operator delete[]
+
+/// \brief Sized array deallocation.
+///
+/// Replacement for the global sized array delete operator to match
+/// operator new[].
+///
+/// \param p Pointer to memory allocated by operator new[].
+
+void operator delete[](void* p, size_t) noexcept{
+  free(p);
+} //operator delete[]
+
+//////////////////////////////////////////////////////////////////////////////
+// Helper functions
+
+/// \brief Random extensible unsigned integer.
+///
+/// Generate a pseudo-random extensible unsigned integer with a given number
+/// of 32-bit words. The most significant word is guaranteed to be non-zero.
+///
+/// \param n Number of words.
+/// \return A pseudo-random extensible unsigned integer with n words.
+
+uintx_t RandomUintx(uint32_t n){
+  std::string s; //hex string
+  char buffer[16]; //buffer for one word
+
+  for(uint32_t i=0; i<n; i++){
+    uint32_t word = g_cPRNG(); //next word
+    if(i == 0 && word == 0)word = 1; //most significant word must be non-zero
+    snprintf(buffer, sizeof(buffer), "%08X", word);
+    s += buffer;
+  } //for
+
+  return uintx_t(s);
+} //RandomUintx
+
+/// \brief Time a function.
+///
+/// Call a function repeatedly until at least MIN_TIME seconds have elapsed
+/// and report the average time per call.
+///
+/// \param f Function to be timed.
+/// \return Average time per call in seconds.
+
+template<class F> double Time(F f){
+  typedef std::chrono::steady_clock clock; //shorthand
+  const auto start = clock::now(); //start time
+  uint32_t count = 0; //number of calls
+  double elapsed = 0; //elapsed time in seconds
+
+  do{
+    f();
+    count++;
+    elapsed = std::chrono::duration<double>(clock::now() - start).count();
+  }while(elapsed < MIN_TIME);
+
+  return elapsed/count;
+} //Time
+
+//////////////////////////////////////////////////////////////////////////////
+// Reference implementations
+
+/// \brief Shift-and-add multiplication.
+///
+/// The multiplication algorithm previously used by uintx_t for operands of
+/// two or more words, which multiplies the first operand by one word of the
+/// second at a time and shifts. This is kept here as a baseline.
+///
+/// \param y First operand.
+/// \param z Second operand.
+/// \return The first operand multiplied by the second.
+
+uintx_t MultiplyShiftAdd(const uintx_t& y, const uintx_t& z){
+  uintx_t result(0), y0(y), z0(z);
+
+  while(z0 > 0){
+    result += y0*to_uint32(z0);
+    y0 <<= 32;
+    z0 >>= 32;
+  } //while
+
+  return result;
+} //MultiplyShiftAdd
+
+/// \brief Square-and-multiply modular power.
+///
+/// Modular exponentiation using only the uintx_t operators, which reduces
+/// each square and product with the remainder operator. This is what
+/// powmodx() is measured against.
+///
+/// \param x Base.
+/// \param e Exponent.
+/// \param m Modulus.
+/// \return The base raised to the power of the exponent, modulo the modulus.
+
+uintx_t PowModSquareMultiply(const uintx_t& x, const uintx_t& e, const uintx_t& m){
+  uintx_t z(1); //result
+
+  for(char c: to_string(e, 2)){
+    z = z*z%m;
+    if(c == '1')z = z*x%m;
+  } //for
+
+  return z;
+} //PowModSquareMultiply
+
+/// \brief Euclid's gcd.
+///
+/// Euclid's algorithm with the remainder operator at every step, which is
+/// what gcdx() used to do. This is kept here as a baseline.
+///
+/// \param x First operand.
+/// \param y Second operand.
+/// \return The greatest common divisor of the operands.
+
+uintx_t GcdEuclid(const uintx_t& x, const uintx_t& y){
+  uintx_t w(x), z(y); //copies of parameters
+
+  while(!w.is_zero()){
+    z %= w;
+    std::swap(z, w);
+  } //while
+
+  return z;
+} //GcdEuclid
+
+//////////////////////////////////////////////////////////////////////////////
+// Benchmark functions
+
+/// \brief Benchmark multiplication.
+///
+/// Time the multiplication of pseudo-random operands of equal size against
+/// the shift-and-add baseline for sizes from 2 to 10,000 words and print
+/// the results to stdout.
+
+void BenchMultiply(){
+  printf("Multiplication (n words by n words)\n");
+  printf("%8s %14s %14s %10s\n", "n", "shift-add", "operator*", "speedup");
+
+  const uint32_t sizes[] = {2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000, 10000};
+
+  for(uint32_t n: sizes){
+    const uintx_t y = RandomUintx(n);
+    const uintx_t z = RandomUintx(n);
+    uintx_t x0, x1; //products
+
+    const double t0 = Time([&](){x0 = MultiplyShiftAdd(y, z);});
+    const double t1 = Time([&](){x1 = y*z;});
+
+    printf("%8u %12.3fus %12.3fus %9.1fx%s\n", n, 1e6*t0, 1e6*t1, t0/t1,
+      x0 == x1? "": " **** mismatch ****");
+  } //for
+
+  printf("\n");
+} //BenchMultiply
+
+/// \brief Benchmark addition and subtraction.
+///
+/// Time the in-place addition and subtraction of pseudo-random operands
+/// of equal size and print the time per word to stdout.
+
+void BenchAddSub(){
+  printf("Addition and subtraction (n words)\n");
+  printf("%8s %14s %14s\n", "n", "x += y", "x -= y");
+
+  const uint32_t sizes[] = {10, 100, 1000, 10000, 100000};
+
+  for(uint32_t n: sizes){
+    const uintx_t y = RandomUintx(n);
+    uintx_t x0 = y; //sum, keeps its size for a very long time
+    uintx_t x1 = y << 32; //difference, stays positive for 2^32 subtractions
+
+    const double t0 = Time([&](){x0 += y;});
+    const double t1 = Time([&](){x1 -= y;});
+
+    printf("%8u %10.3fns/w %10.3fns/w\n", n, 1e9*t0/n, 1e9*t1/n);
+  } //for
+
+  printf("\n");
+} //BenchAddSub
+
+/// \brief Benchmark squaring.
+///
+/// Compare the time taken to square an extensible unsigned integer against
+/// the time taken to multiply it by a copy of itself, for a range of
+/// operand sizes, and print the results to stdout.
+
+void BenchSquare(){
+  printf("Squaring (n words)\n");
+  printf("%8s %14s %14s %10s\n", "n", "x*y", "x*x", "speedup");
+
+  const uint32_t sizes[] = {2, 5, 10, 20, 50, 100, 200, 500, 1000, 2000, 5000,
+    10000, 50000};
+
+  for(uint32_t n: sizes){
+    const uintx_t x = RandomUintx(n);
+    const uintx_t y = x; //a copy of x
+    uintx_t x0, x1; //products
+
+    const double t0 = Time([&](){x0 = x*y;});
+    const double t1 = Time([&](){x1 = x*x;});
+
+    printf("%8u %12.3fus %12.3fus %9.1fx%s\n", n, 1e6*t0, 1e6*t1, t0/t1,
+      x0 == x1? "": " **** mismatch ****");
+  } //for
+
+  printf("\n");
+} //BenchSquare
+
+/// \brief Benchmark moves.
+///
+/// Count the arrays and words allocated by some common operations on
+/// 100-word operands, and print the results to stdout. Each operation is
+/// done twice, once with the result copied out of a const temporary, which
+/// is what happened before uintx_t had move semantics, and once as written,
+/// which moves the result instead.
+
+void BenchMoves(){
+  printf("Allocations per operation (100 words)\n");
+  printf("%-12s %10s %10s %10s %10s\n", "", "copy", "move", "copy", "move");
+  printf("%-12s %10s %10s %10s %10s\n", "operation", "arrays", "arrays", "words", "words");
+
+  const uint32_t n = 100; //number of words
+  const uintx_t y = RandomUintx(n);
+  const uintx_t z = RandomUintx(n);
+  const uintx_t w = RandomUintx(n/2);
+  uintx_t x; //result
+
+  typedef const uintx_t& copy; //cast to force a copy
+
+  struct{
+    const char* name; //name of operation
+    std::function<void()> copied; //operation with copying
+    std::function<void()> moved; //operation with moving
+  }op[] = {
+    {"x = y + z", [&](){x = copy(y + z);}, [&](){x = y + z;}},
+    {"x = y - w", [&](){x = copy(y - w);}, [&](){x = y - w;}},
+    {"x = y*z", [&](){x = copy(y*z);}, [&](){x = y*z;}},
+    {"x = y/w", [&](){x = copy(y/w);}, [&](){x = y/w;}},
+    {"x = y << 5", [&](){x = copy(y << 5);}, [&](){x = y << 5;}},
+    {"x *= z", [&](){x = copy(x*z);}, [&](){x *= z;}},
+    {"x /= w", [&](){x = copy(x/w);}, [&](){x /= w;}},
+  }; //op
+
+  for(auto& o: op){
+    uint64_t count[2], bytes[2]; //arrays and bytes allocated
+
+    for(int i=0; i<2; i++){
+      x = y; //same starting point each time
+      g_nAllocCount = g_nAllocBytes = 0;
+      i == 0? o.copied(): o.moved();
+      count[i] = g_nAllocCount;
+      bytes[i] = g_nAllocBytes;
+    } //for
+
+    printf("%-12s %10llu %10llu %10llu %10llu\n", o.name,
+      (unsigned long long)count[0], (unsigned long long)count[1],
+      (unsigned long long)bytes[0]/sizeof(uint32_t),
+      (unsigned long long)bytes[1]/sizeof(uint32_t));
+  } //for
+
+  printf("\n");
+} //BenchMoves
+
+/// \brief Benchmark small values.
+///
+/// Measure the time and number of heap allocations per operation on
+/// operands small enough to be held inside a uintx_t without using the
+/// heap, and print the results to stdout. The products of the 128-bit
+/// operands are larger than 128 bits, so they spill over onto the heap.
+
+void BenchSmall(){
+  printf("Small values\n");
+  printf("%-12s %10s %10s %10s %10s\n", "", "64-bit", "64-bit", "128-bit", "128-bit");
+  printf("%-12s %10s %10s %10s %10s\n", "operation", "ns", "arrays", "ns", "arrays");
+
+  const uintx_t y[2] = {RandomUintx(2), RandomUintx(4)};
+  const uintx_t z[2] = {RandomUintx(2), RandomUintx(3)};
+  uintx_t x; //result
+  int j = 0; //operand index
+
+  struct{
+    const char* name; //name of operation
+    std::function<void()> f; //operation
+  }op[] = {
+    {"x = y + z", [&](){x = y[j] + z[j];}},
+    {"x = y - z", [&](){x = y[j] - z[j];}},
+    {"x = y*z", [&](){x = y[j]*(z[j] >> 64*j);}},
+    {"x = y/z", [&](){x = y[j]/z[j];}},
+    {"x = y%z", [&](){x = y[j]%z[j];}},
+    {"x = y*7", [&](){x = y[j]*7;}},
+  }; //op
+
+  for(auto& o: op){
+    double t[2]; //time per operation
+    uint64_t count[2]; //arrays allocated per operation
+
+    for(j=0; j<2; j++){
+      t[j] = Time(o.f);
+      g_nAllocCount = 0;
+      o.f();
+      count[j] = g_nAllocCount;
+    } //for
+
+    printf("%-12s %10.1f %10llu %10.1f %10llu\n", o.name,
+      t[0]*1e9, (unsigned long long)count[0],
+      t[1]*1e9, (unsigned long long)count[1]);
+  } //for
+
+  printf("\n");
+} //BenchSmall
+
+/// \brief Benchmark accumulators.
+///
+/// Measure the number of heap allocations made by accumulator loops that
+/// update a value in place, and print the results to stdout.
+
+void BenchAccumulate(){
+  printf("Allocations per accumulator loop\n");
+  printf("%-24s %10s %10s\n", "loop", "arrays", "words");
+
+  struct{
+    const char* name; //name of loop
+    std::function<void()> f; //loop
+  }op[] = {
+    {"factorialx(10000)", [](){factorialx(10000);}},
+    {"x *= 3 10000 times", [](){uintx_t x(1); for(int i=0; i<10000; i++)x *= 3;}},
+    {"x += x 10000 times", [](){uintx_t x(1); for(int i=0; i<10000; i++)x += x;}},
+  }; //op
+
+  for(auto& o: op){
+    g_nAllocCount = g_nAllocBytes = 0;
+    o.f();
+    printf("%-24s %10llu %10llu\n", o.name, (unsigned long long)g_nAllocCount,
+      (unsigned long long)g_nAllocBytes/sizeof(uint32_t));
+  } //for
+
+  printf("\n");
+} //BenchAccumulate
+
+/// \brief Benchmark the kernel variants.
+///
+/// Time some operations that use the kernels with versions for different
+/// instruction sets, once with each variant that the processor supports,
+/// and print the results to stdout. Schoolbook multiplication uses
+/// addmul_1(), and the shift pair and exclusive-or use the shift and
+/// bitwise kernels. The kernel variant in use beforehand is restored
+/// afterwards.
+
+void BenchKernels(){
+  printf("Kernel variants (selected at startup: %s)\n", get_kernels());
+  printf("%-8s %14s %14s %14s\n", "variant", "x*y 20 words", "x<<=13 x>>=13",
+    "x ^= y");
+
+  const std::string kernels = get_kernels(); //variant in use
+  const char* variants[] = {"scalar", "adx", "avx2", "avx512"}; //all variants
+  const uint32_t n = 10000; //words for the shifts and exclusive-or
+
+  const uintx_t y = RandomUintx(20);
+  const uintx_t z = RandomUintx(20);
+  const uintx_t w = RandomUintx(n);
+  const uintx_t u = RandomUintx(n);
+
+  for(const char* v: variants){
+    if(!set_kernels(v)){
+      printf("%-8s %14s\n", v, "not supported");
+      continue;
+    } //if
+
+    uintx_t x0, x1 = w, x2 = u; //results
+
+    const double t0 = Time([&](){x0 = y*z;});
+    const double t1 = Time([&](){x1 <<= 13; x1 >>= 13;});
+    const double t2 = Time([&](){x2 ^= w;});
+
+    printf("%-8s %12.3fns %10.3fns/w %10.3fns/w\n", v, 1e9*t0, 1e9*t1/n,
+      1e9*t2/n);
+  } //for
+
+  set_kernels(kernels.c_str());
+  printf("\n");
+} //BenchKernels
+
+/// \brief Benchmark prepared divisors.
+///
+/// Time the reduction of pseudo-random 2n-word dividends modulo the same
+/// n-word divisor with the remainder operator and with a uintx_divisor,
+/// and print the results to stdout along with the number of arrays that
+/// each allocates per reduction.
+
+void BenchDivisor(){
+  printf("Repeated remainder (2n words mod the same n words)\n");
+  printf("%8s %14s %14s %10s %10s %10s\n", "n", "x % y", "d.divmod()",
+    "speedup", "x % y", "divmod()");
+  printf("%8s %14s %14s %10s %10s %10s\n", "", "", "", "", "arrays", "arrays");
+
+  const uint32_t count = 64; //number of dividends
+
+  for(uint32_t n: {1, 2, 8, 32, 128}){
+    const uintx_t y = RandomUintx(n);
+    const uintx_divisor d(y);
+    uintx_t x[count]; //dividends
+    uintx_t q, r; //quotient and remainder
+
+    for(uint32_t i=0; i<count; i++)
+      x[i] = RandomUintx(2*n);
+
+    const double t0 = Time([&](){for(auto& z: x)r = z%y;});
+    const double t1 = Time([&](){for(auto& z: x)d.divmod(z, q, r);});
+
+    g_nAllocCount = 0;
+    for(auto& z: x)r = z%y;
+    const double a0 = double(g_nAllocCount)/count;
+
+    g_nAllocCount = 0;
+    for(auto& z: x)d.divmod(z, q, r);
+    const double a1 = double(g_nAllocCount)/count;
+
+    printf("%8u %12.1fns %12.1fns %10.2f %10.2f %10.2f\n", n, 1e9*t0/count,
+      1e9*t1/count, t0/t1, a0, a1);
+  } //for
+
+  printf("\n");
+} //BenchDivisor
+
+/// \brief Benchmark modular powers.
+///
+/// Time modular exponentiation with a pseudo-random odd modulus and
+/// exponent of the same size using powmodx() against the square-and-multiply
+/// baseline and print the results to stdout.
+
+void BenchPowMod(){
+  printf("Modular power (n-bit base, exponent, and odd modulus)\n");
+  printf("%8s %14s %14s %10s %10s\n", "n", "x*y%m", "powmodx()", "speedup", "per second");
+
+  for(uint32_t n: {256, 512, 1024, 2048, 4096}){
+    const uintx_t m = RandomUintx(n/32) | 1;
+    const uintx_t e = RandomUintx(n/32);
+    const uintx_t x = RandomUintx(n/32)%m;
+    uintx_t z0, z1; //results
+
+    const double t0 = Time([&](){z0 = PowModSquareMultiply(x, e, m);});
+    const double t1 = Time([&](){z1 = powmodx(x, e, m);});
+
+    printf("%8u %12.1fus %12.1fus %10.2f %10.0f%s\n", n, 1e6*t0, 1e6*t1, t0/t1,
+      1/t1, z0 == z1? "": " (wrong)");
+  } //for
+
+  printf("\n");
+} //BenchPowMod
+
+/// \brief Benchmark residues.
+///
+/// Time modular multiplication of pseudo-random n-bit numbers by an odd
+/// modulus using uintx_t multiplication followed by the remainder operator
+/// against residues, and print the results to stdout along with the number
+/// of arrays that each allocates per multiplication.
+
+void BenchResidue(){
+  printf("Modular multiplication (n-bit odd modulus)\n");
+  printf("%8s %14s %14s %10s %10s %10s\n", "n", "x*y%m", "a *= b", "speedup",
+    "x*y%m", "a *= b");
+  printf("%8s %14s %14s %10s %10s %10s\n", "", "", "", "", "arrays", "arrays");
+
+  for(uint32_t n: {256, 512, 1024, 2048, 4096}){
+    const uintx_t m = RandomUintx(n/32) | 1;
+    const uintx_t y = RandomUintx(n/32)%m;
+    const uintx_montgomery mont(m); //Montgomery context
+    const modx_t b(mont, y); //y as a residue
+    uintx_t x = RandomUintx(n/32)%m; //accumulator
+    modx_t a(mont, x); //accumulator as a residue
+
+    const double t0 = Time([&](){x = x*y%m;});
+    const double t1 = Time([&](){a *= b;});
+
+    g_nAllocCount = 0;
+    x = x*y%m;
+    const uint32_t a0 = g_nAllocCount;
+
+    g_nAllocCount = 0;
+    a *= b;
+    const uint32_t a1 = g_nAllocCount;
+
+    printf("%8u %12.1fns %12.1fns %10.2f %10u %10u\n", n, 1e9*t0, 1e9*t1, t0/t1,
+      a0, a1);
+  } //for
+
+  printf("\n");
+} //BenchResidue
+
+/// \brief Benchmark gcd.
+///
+/// Time the greatest common divisor of pseudo-random operands of equal size
+/// with a common factor of a quarter of their size using gcdx() against
+/// Euclid's algorithm, and print the results to stdout.
+
+void BenchGcd(){
+  printf("Greatest common divisor (n 32-bit words)\n");
+  printf("%8s %14s %14s %10s\n", "n", "Euclid", "gcdx()", "speedup");
+
+  for(uint32_t n: {4, 32, 256, 2048}){
+    const uintx_t g = RandomUintx(n/4); //common factor
+    const uintx_t x = RandomUintx(n - n/4)*g;
+    const uintx_t y = RandomUintx(n - n/4)*g;
+    uintx_t z0, z1; //results
+
+    const double t0 = Time([&](){z0 = GcdEuclid(x, y);});
+    const double t1 = Time([&](){z1 = gcdx(x, y);});
+
+    printf("%8u %12.1fus %12.1fus %10.2f%s\n", n, 1e6*t0, 1e6*t1, t0/t1,
+      z0 == z1? "": " (wrong)");
+  } //for
+
+  printf("\n");
+} //BenchGcd
+
+/// \brief Benchmark hex conversion.
+///
+/// Time conversion of pseudo-random operands to hex strings with
+/// to_hexstring() and back with the string constructor for sizes from
+/// 1,000 to 1,000,000 32-bit words, and print the results to stdout as
+/// gigabytes of hex digits per second.
+
+void BenchHex(){
+  printf("Hex conversion (n 32-bit words, 8n digits)\n");
+  printf("%8s %14s %14s\n", "n", "to_hexstring", "from hex");
+
+  for(uint32_t n: {1000, 100000, 1000000}){
+    const uintx_t x = RandomUintx(n);
+    const std::string s = to_hexstring(x);
+    std::string t; //encoded string
+    uintx_t y; //decoded value
+
+    const double t0 = Time([&](){t = to_hexstring(x);});
+    const double t1 = Time([&](){y = uintx_t(s);});
+
+    printf("%8u %10.2fGB/s %10.2fGB/s\n", n, 1e-9*s.size()/t0,
+      1e-9*s.size()/t1);
+  } //for
+
+  printf("\n");
+} //BenchHex
+
+//////////////////////////////////////////////////////////////////////////////
+// Main
+
+/// \brief Main.
+///
+/// Run the benchmarks and print the results to stdout.
+///
+/// \return 0 (what could possibly go wrong?)
+
+int main(){
+  BenchMultiply();
+  BenchSquare();
+  BenchAddSub();
+  BenchMoves();
+  BenchSmall();
+  BenchAccumulate();
+  BenchKernels();
+  BenchHex();
+  BenchDivisor();
+  BenchPowMod();
+  BenchResidue();
+  BenchGcd();
+
+  return 0; //what could possibly go wrong?
+} //main
@@ -49,7 +49,7 @@ CNode::~CNode(){
 /// Evaluate the arithmetic expression rooted at this node.
 /// \return The value of arithmetic expression rooted at this node.
 
-const uintx_t CNode::evaluate() const{
+uintx_t CNode::evaluate() const{
   uintx_t operand0 = 0; //the first operand
   uintx_t operand1 = 0; //the second operand
   uintx_t result = 0; //the return result
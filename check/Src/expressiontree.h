@@ -45,7 +45,7 @@ class CNode{
     
     ~CNode(); ///< Destructor.
 
-    const uintx_t evaluate() const; ///< Evaluate expression sub-tree.
+    uintx_t evaluate() const; ///< Evaluate expression sub-tree.
     void postorder(std::string& s) const; ///< Postorder traversal of sub-tree.
     void inorder(std::string& s) const; ///< Inorder traversal of sub-tree.
 }; //CNode
\ No newline at end of file
@@ -87,14 +87,17 @@ bool CLex::getsymbol(){
 } //getsymbol
 
 /// Get a number. Assumes that `m_strBuffer[m_nCurChar]` is a digit. 
-/// Reads the unsigned number starting there into `m_nNumber`.
+/// Reads the unsigned number starting there into `m_nNumber`. The digits
+/// are found first and then converted all at once by from_string(), which
+/// is much faster than appending them one at a time for long numbers.
 
 void CLex::getnumber(){
-  m_nNumber = 0;
+  const size_t start = m_nCurChar; //index of first digit
 
-  do{ //must have at least one digit
-    m_nNumber = m_nNumber*10 + m_strBuffer[m_nCurChar++] - '0';
-  }while(m_nCurChar < m_nStrLen && isNumeric(m_strBuffer[m_nCurChar]));
+  do m_nCurChar++; //must have at least one digit
+  while(m_nCurChar < m_nStrLen && isNumeric(m_strBuffer[m_nCurChar]));
+
+  m_nNumber = from_string(m_strBuffer.substr(start, m_nCurChar - start));
 } //getnumber
 
 /// Get an identifier from `m_strBuffer` into `m_strIdentifier`.
@@ -204,7 +204,7 @@ bool CParser::parse(const std::string& s){
 /// Evaluate the expression tree with root pointed to by `m_pExpressionTree`.
 /// \return The result of evaluating the parsed arithmetic expression.
 
-const uintx_t CParser::evaluate() const{
+uintx_t CParser::evaluate() const{
   return m_pExpressionTree->evaluate();
 } //evaluate
 
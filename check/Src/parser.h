@@ -93,7 +93,7 @@ class CParser: public CLex{
 
   public:  
     bool parse(const std::string& s); ///< Parse a string.
-    const uintx_t evaluate() const; ///< Evaluate arithmetic expression.  
+    uintx_t evaluate() const; ///< Evaluate arithmetic expression.  
     const std::string GetPostfixString() const; ///< Get postfix string. 
     const std::string GetInfixString() const; ///< Get infix string.
 }; //CParser
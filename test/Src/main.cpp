@@ -3,6 +3,14 @@
 
 #include "uintx_t.h"
 #include "uintx_math.h"
+#include "uintx_tune.h"
+#include "uintx_divisor.h"
+#include "uintx_montgomery.h"
+#include "modx_t.h"
+
+#include <algorithm>
+#include <thread>
+#include <vector>
 
 uint32_t g_nTestCount = 0; ///< Number of tests performed.
 uint32_t g_nPassCount = 0; ///< Number of tests passed.
@@ -34,8 +42,10 @@ void ReportTestResult(bool result){
 /// \brief Test division and remainder operations.
 ///
 /// Test the extensible unsigned integer division and remainder operations and
-/// print the result to stdout. The test performed is 
-/// \f$x \bmod y < y\f$ and \f$y\lfloor x/y\rfloor + (x\bmod y) = x\f$.
+/// print the result to stdout. The quotient and remainder are computed
+/// together by divmodx() and the test performed is 
+/// \f$x \bmod y < y\f$ and \f$y\lfloor x/y\rfloor + (x\bmod y) = x\f$,
+/// and that they agree with the division and remainder operators.
 ///
 /// \param x Numerator.
 /// \param y Denominator.
@@ -47,12 +57,12 @@ void TestDivMod(const uintx_t& x, const uintx_t& y){
   printf("x             = %s\n", to_commastring(x).c_str());
   printf("y             = %s\n", to_commastring(y).c_str());
 
-  const uintx_t frac = x/y;
+  uintx_t frac, rem; //quotient and remainder
+  divmodx(x, y, frac, rem);
   printf("x/y           = %s\n", to_commastring(frac).c_str());
-
-  const uintx_t rem = x%y;
   printf("x%%y           = %s\n", to_commastring(rem).c_str());
   if(rem >= y)result = false;
+  if(frac != x/y || rem != x%y)result = false;
 
   const uintx_t x2 = frac*y + rem;
   printf("(x/y)*y + x%%y = %s\n", to_commastring(x2).c_str());
@@ -61,6 +71,288 @@ void TestDivMod(const uintx_t& x, const uintx_t& y){
   ReportTestResult(result);
 } //TestDivMod
 
+/// \brief Test recursive division.
+///
+/// Test the extensible unsigned integer division and remainder operations
+/// on operands large enough for Burnikel-Ziegler division and print the
+/// result to stdout. The tests performed are that \f$x \bmod y < y\f$ and
+/// \f$y\lfloor x/y\rfloor + (x\bmod y) = x\f$, and that the quotient and
+/// remainder are the same as those given by long division alone.
+///
+/// \param x Numerator.
+/// \param y Denominator.
+
+void TestRecursiveDivision(const uintx_t& x, const uintx_t& y){
+  printf("Recursive division test: x%%y < y, (x/y)*y + x%%y == x, same as long division\n");
+  bool result = true;
+
+  uintx_t q, r; //quotient and remainder
+  divmodx(x, y, q, r);
+  if(r >= y || q*y + r != x)result = false;
+
+  const uint32_t threshold = g_nBZThreshold; //save threshold
+  g_nBZThreshold = UINT32_MAX; //long division only
+  if(x/y != q || x%y != r)result = false;
+  g_nBZThreshold = threshold; //restore threshold
+
+  printf("x has %u bits, y has %u bits, x/y has %u bits\n", log2x(x) + 1,
+    log2x(y) + 1, log2x(q) + 1);
+
+  ReportTestResult(result);
+} //TestRecursiveDivision
+
+/// \brief Test prepared divisors.
+///
+/// Test division by a uintx_divisor and print the result to stdout. The
+/// tests performed are that its quotients and remainders are the same as
+/// those of the division and remainder operators for dividends from the
+/// size of the divisor to several times that, for dividends smaller than
+/// the divisor, for a single-word divisor, and when a result is the same
+/// object as the dividend, that divmod() does not change the capacity of
+/// results that are already large enough, and that dividing by zero or NaN
+/// gives NaN.
+///
+/// \param x Dividend.
+/// \param y Divisor.
+
+void TestDivisor(const uintx_t& x, const uintx_t& y){
+  printf("Prepared divisor test: same results as x/y and x%%y\n");
+  bool result = true;
+
+  const uintx_divisor d(y), d1(1000000007); //prepared divisors
+  uintx_t q, r; //quotient and remainder
+  q.reserve(x.capacity());
+  r.reserve(x.capacity());
+  const uint32_t qcap = q.capacity(), rcap = r.capacity(); //reserved capacities
+
+  for(int32_t k=0; k<=int32_t(log2x(x)); k+=97){
+    const uintx_t z = x >> k; //dividend
+
+    d.divmod(z, q, r);
+    if(q != z/y || r != z%y || d.div(z) != q || d.mod(z) != r)
+      result = false;
+
+    if(d1.mod(z) != z%1000000007 || d1.div(z) != z/1000000007)
+      result = false;
+  } //for
+
+  if(q.capacity() != qcap || r.capacity() != rcap)
+    result = false;
+
+  q = x; r = x; //aliased dividend and result
+  d.divmod(q, q, r);
+  if(q != x/y || r != x%y)result = false;
+
+  if(d.mod(y - 1) != y - 1 || d.div(y - 1) != 0 || d.mod(y) != 0)
+    result = false;
+
+  if(uintx_divisor(0).mod(x) != uintx_t::NaN ||
+    uintx_divisor(uintx_t::NaN).div(x) != uintx_t::NaN ||
+    d.mod(uintx_t::NaN) != uintx_t::NaN)
+      result = false;
+
+  printf("x has %u bits, y has %u bits\n", log2x(x) + 1, log2x(y) + 1);
+
+  ReportTestResult(result);
+} //TestDivisor
+
+/// \brief Test built-in integer operands.
+///
+/// Test the extensible unsigned integer arithmetic and comparison operators
+/// with built-in integer operands and print the result to stdout. The test
+/// performed is that each operator gives the same result as it does when the
+/// built-in integer is first converted to an extensible unsigned integer, for
+/// operands of both one and two words.
+///
+/// \param x An extensible unsigned integer.
+
+void TestBuiltin(const uintx_t& x){
+  printf("Built-in operand test: x op n == x op uintx_t(n) for op in +-*/%% and comparisons\n");
+  printf("x has %u bits\n", log2x(x) + 1);
+  bool result = true;
+
+  const uint64_t n[] = {1, 10, 0xFFFFFFFF, 0x100000000, 0xFEDCBA9876543210};
+
+  for(uint64_t i: n){
+    const uintx_t y(i); //i as an extensible unsigned integer
+    uintx_t z(x); //for the compound operators
+
+    if(x + i != x + y || i + x != x + y || (z += i) != x + y)result = false;
+    if(x - i != x - y || (z -= i) != x)result = false;
+    if(x*i != x*y || i*x != x*y || (z *= i) != x*y)result = false;
+    if(x/i != x/y || (z /= i) != x)result = false;
+    if(x%i != x%y || (z %= i) != x%y)result = false;
+
+    if((x > i) != (x > y) || (x >= i) != (x >= y) || (x < i) != (x < y) ||
+      (x <= i) != (x <= y) || (x == i) != (x == y) || (x != i) != (x != y) ||
+      compare(x, i) != compare(x, y))result = false;
+
+    if(y != i || y < i || y > i || compare(y, i) != 0 || y.is_zero())
+      result = false;
+
+    printf("n = 0x%s: %s\n", to_hexstring(y).c_str(), result? "ok": "failed");
+  } //for
+
+  ReportTestResult(result);
+} //TestBuiltin
+
+/// \brief Test storage capacity.
+///
+/// Test the extensible unsigned integer storage functions and print the
+/// result to stdout. The tests performed are that an accumulator grows up
+/// to its reserved capacity without reallocating, that it keeps its
+/// capacity when it shrinks, and that shrink_to_fit() gives back the
+/// unused space without changing its value. The accumulator is checked
+/// against a copy computed without reserving space.
+///
+/// \param n Number of words to reserve.
+
+void TestCapacity(uint32_t n){
+  printf("Capacity test: reserve(%u), grow, shrink, and shrink_to_fit\n", n);
+  bool result = true;
+
+  uintx_t x(1), y(1); //accumulators with and without reserved space
+  x.reserve(n);
+  const uint32_t capacity = x.capacity(); //reserved capacity
+
+  if(capacity < n)result = false;
+
+  while(log2x(x) < 8*sizeof(word_t)*(n - 1)){ //grow to nearly n words
+    x *= 3; x += 1;
+    y *= 3; y += 1;
+  } //while
+
+  if(x.capacity() != capacity || x != y)result = false;
+
+  x %= 1000; y %= 1000; //shrink
+  const uint32_t shrunk = x.capacity(); //capacity after shrinking
+  if(shrunk != capacity || x != y)result = false;
+
+  x.shrink_to_fit();
+  if(x.capacity() >= capacity || x != y)result = false;
+
+  printf("capacity %u, after growing and shrinking %u, after shrink_to_fit %u\n",
+    capacity, shrunk, x.capacity());
+
+  ReportTestResult(result);
+} //TestCapacity
+
+/// \brief Test results that must not depend on the word size.
+///
+/// Test the extensible unsigned integer arithmetic, bitwise, shift, and
+/// conversion operations on operands that straddle 32-bit and 64-bit word boundaries,
+/// and print the result to stdout. The test performed is that the hex and
+/// decimal strings of the results match precomputed values, so the library
+/// must pass it whether it is compiled with 32-bit words or with 64-bit words
+/// (`UINTX_WORD64` defined).
+
+void TestWords(){
+  printf("Word size test: results are the same for %u-bit words\n",
+    (uint32_t)(8*sizeof(word_t)));
+  bool result = true;
+
+  const uintx_t x("1FFFFFFFFFFFFFFFF00000001");
+  const uintx_t y("123456789012345678901234567890");
+  const uintx_t z = x*x; //square
+
+  printf("x             = %s\n", to_hexstring(x).c_str());
+  printf("y             = %s\n", to_hexstring(y).c_str());
+  printf("x*x           = %s\n", to_string(z).c_str());
+
+  if(to_string(z) != "25108406941546723053982028225463824460631427442568360624129" ||
+     to_hexstring(z) != "3FFFFFFFFFFFFFFFC0000000400000000FFFFFFFE00000001")
+    result = false;
+
+  if(to_hexstring(z + y) != "3FFFFFFFFFFFFFFFC0012345A789012355678901034567891" ||
+     to_hexstring(z - y) != "3FFFFFFFFFFFFFFFBFFEDCBAD876FEDCCA9876FEBCBA98771")
+    result = false;
+
+  if(to_hexstring(z/y) != "3840000020F57FFFDB30" ||
+     to_hexstring(z%y) != "EAF3A390012B03639000CAF363501")
+    result = false;
+
+  const uint64_t w = 0xFFFFFFFFFFFFFFFFULL; //largest 64-bit operand
+
+  if(to_hexstring(x*w) != "1FFFFFFFFFFFFFFFD0000000100000000FFFFFFFF" ||
+     to_hexstring(z/w) != "400000000000000000000000400000001" ||
+     to_uint64(z%w) != 8589934594ULL)
+    result = false;
+
+  if(to_hexstring(x << 77) != "3FFFFFFFFFFFFFFFE000000020000000000000000000")
+    result = false;
+
+  if(uintx_t(to_hexstring(z)) != z || to_uint64(x) != 0xFFFFFFFF00000001ULL)
+    result = false;
+
+  //bitwise operators on values whose top 64-bit word is only half used
+
+  const uintx_t h("80000000"), g("123456789"); //one and one and a bit 32-bit words
+
+  if(to_hexstring(~h) != "7FFFFFFF" || to_hexstring(~g) != "FFFFFFFEDCBA9876" ||
+     to_hexstring(~uintx_t(0)) != "FFFFFFFF" || to_hexstring(~x) != "FFFFFFFE0000000000000000FFFFFFFE")
+    result = false;
+
+  if(to_hexstring(g & x) != "100000001" || to_hexstring(h | g) != "1A3456789" ||
+     to_hexstring(g ^ x) != "1FFFFFFFFFFFFFFFE23456788" ||
+     to_hexstring(~(g ^ h)) != "FFFFFFFE5CBA9876" || (~~g & g) != g)
+    result = false;
+
+  ReportTestResult(result);
+} //TestWords
+
+/// \brief Test shifts.
+///
+/// Test the extensible unsigned integer shift operators and lshiftx() and
+/// rshiftx(), which shift into a destination, and print the result to
+/// stdout. The tests performed are that \f$(x \ll k) \gg k = x\f$ and
+/// \f$(x \gg k) \ll k = x - (x \bmod 2^k)\f$ for shift distances on both
+/// sides of word boundaries and beyond the size of \f$x\f$, that lshiftx()
+/// and rshiftx() agree with the operators and do not change \f$x\f$, and
+/// that shifting into the same destination does not change its capacity.
+///
+/// \param x An extensible unsigned integer.
+
+void TestShift(const uintx_t& x){
+  printf("Shift test: (x << k) >> k = x, (x >> k) << k = x - (x mod 2^k)\n");
+  bool result = true;
+
+  const uintx_t x0(x); //copy of x for checking that it does not change
+  const int32_t bits = log2x(x) + 1; //number of bits in x
+  const uint32_t words = (2*bits + 70)/(8*sizeof(word_t)) + 2; //enough for any y
+  uintx_t y, z; //destinations for lshiftx() and rshiftx()
+  y.reserve(words);
+  z.reserve(words);
+  const uint32_t ycap = y.capacity(), zcap = z.capacity(); //reserved capacities
+
+  for(int32_t k=0; k<=bits + 70; k+=(k < 130? 1: 7)){
+    lshiftx(x, k, y);
+    rshiftx(x, k, z);
+
+    if(y != (x << k) || z != (x >> k) || (y >> k) != x)
+      result = false;
+
+    if(k < 200 && (z << k) != x - x%(uintx_t(1) << k))
+      result = false;
+
+    if(k >= bits && !z.is_zero())
+      result = false;
+  } //for
+
+  y = x; z = x; //aliased source and destination
+  lshiftx(y, 93, y);
+  rshiftx(z, 93, z);
+  if(y != (x << 93) || z != (x >> 93))result = false;
+
+  if(x != x0 || y.capacity() != ycap || z.capacity() != zcap)
+    result = false;
+
+  printf("x             = %s\n", to_hexstring(x).c_str());
+  printf("x << 93       = %s\n", to_hexstring(x << 93).c_str());
+  printf("x >> 93       = %s\n", to_hexstring(x >> 93).c_str());
+
+  ReportTestResult(result);
+} //TestShift
+
 /// \brief Test Fibonacci numbers.
 ///
 /// Test the extensible unsigned integer Fibonacci number function and print
@@ -141,6 +433,241 @@ void TestGcd(const uintx_t& x, const uintx_t& y){
   ReportTestResult(result);
 } //TestGcd
 
+/// \brief Test the gcd of large operands.
+///
+/// Test the extensible unsigned integer greatest common divisor function on
+/// operands large enough for the half-GCD algorithm and print the result to
+/// stdout. The tests performed are that the gcd divides both operands,
+/// that the gcd of the quotients is 1, that the gcd is the same as that
+/// given by Lehmer's algorithm alone, that \f$\text{lcm}(x, y)\gcd(x, y)
+/// = xy\f$, and that exact division by the gcd gives the same quotient
+/// as the division operator.
+///
+/// \param x First extensible unsigned integer.
+/// \param y Second extensible unsigned integer.
+
+void TestLargeGcd(const uintx_t& x, const uintx_t& y){
+  printf("Large gcd test: gcd(x, y) divides x and y, gcd(x/gcd(x, y), y/gcd(x, y)) == 1,\n");
+  printf("  same as Lehmer's algorithm, and lcm(x, y)*gcd(x, y) == x*y\n");
+  bool result = true;
+
+  const uintx_t z = gcdx(x, y);
+  const uintx_t x0 = divexactx(x, z), y0 = divexactx(y, z); //quotients
+  if(x0 != x/z || y0 != y/z || x0*z != x || y0*z != y)result = false;
+  if(gcdx(x0, y0) != 1)result = false;
+
+  const uint32_t threshold = g_nGCDThreshold; //save threshold
+  g_nGCDThreshold = UINT32_MAX; //Lehmer's algorithm only
+  if(gcdx(x, y) != z)result = false;
+  g_nGCDThreshold = threshold; //restore threshold
+
+  if(lcmx(x, y)*z != x*y)result = false;
+
+  printf("x has %u bits, y has %u bits, gcd(x, y) has %u bits\n", log2x(x) + 1,
+    log2x(y) + 1, log2x(z) + 1);
+
+  ReportTestResult(result);
+} //TestLargeGcd
+
+/// \brief Test multiplication.
+///
+/// Test the extensible unsigned integer multiplication operator on large
+/// operands and print the result to stdout. The product is computed once
+/// with the default algorithm thresholds and again using only schoolbook
+/// multiplication, and the test performed is that they are equal.
+///
+/// \param x First extensible unsigned integer.
+/// \param y Second extensible unsigned integer.
+
+void TestMultiply(const uintx_t& x, const uintx_t& y){
+  printf("Multiplication test: x*y == x*y computed by schoolbook\n");
+
+  printf("x has %u bits\n", log2x(x) + 1);
+  printf("y has %u bits\n", log2x(y) + 1);
+
+  const uintx_t z = x*y;
+  printf("x*y has %u bits\n", log2x(z) + 1);
+
+  const uint32_t k = g_nKaratsubaThreshold; //save thresholds
+  const uint32_t t = g_nToom3Threshold;
+  const uint32_t f = g_nNTTThreshold;
+
+  g_nKaratsubaThreshold = g_nToom3Threshold = g_nNTTThreshold = UINT32_MAX;
+  const uintx_t z0 = x*y; //schoolbook only
+
+  g_nKaratsubaThreshold = k; //restore thresholds
+  g_nToom3Threshold = t;
+  g_nNTTThreshold = f;
+
+  ReportTestResult(z == z0);
+} //TestMultiply
+
+/// \brief Test squaring.
+///
+/// Test the extensible unsigned integer squaring algorithms and print the
+/// result to stdout. The multiplication operator squares when both of its
+/// operands are the same object, so the test performed is that this gives
+/// the same result as multiplying by a copy.
+///
+/// \param x An extensible unsigned integer.
+
+void TestSquare(const uintx_t& x){
+  printf("Squaring test: x*x == x*y where y is a copy of x\n");
+  printf("x has %u bits\n", log2x(x) + 1);
+
+  const uintx_t y = x; //a copy of x
+  const uintx_t z = x*x;
+  printf("x*x has %u bits\n", log2x(z) + 1);
+
+  ReportTestResult(z == x*y);
+} //TestSquare
+
+/// \brief Test the kernel variants.
+///
+/// Test the kernel variants for different instruction sets and print the
+/// result to stdout. Each variant that the processor supports is selected
+/// in turn, and the test performed is that multiplication, shifts, and the
+/// bitwise operators give the same results as they do with the scalar
+/// kernels. The bitwise operators are also checked against the identity
+/// \f$x | y = (x \oplus y) + (x \,\&\, y)\f$ in both orders, which only holds
+/// if the operands are of different lengths when the words of the longer
+/// one are used. The kernel variant in use beforehand is restored afterwards.
+///
+/// \param x An extensible unsigned integer.
+/// \param y An extensible unsigned integer.
+
+void TestKernels(const uintx_t& x, const uintx_t& y){
+  printf("Kernel variant test: all variants give the same results as scalar\n");
+  bool result = true;
+
+  const std::string kernels = get_kernels(); //variant in use
+  const char* variants[] = {"scalar", "adx", "avx2", "avx512"}; //all variants
+  const uint32_t n = 9; //number of results per variant
+  uintx_t expected[n]; //results with the scalar kernels
+
+  for(const char* v: variants){
+    if(!set_kernels(v)){
+      printf("%-7s not supported\n", v);
+      continue;
+    } //if
+
+    const uintx_t z[n] = {x*y, x*x, x << 77, x >> 45, x & y, x | y, x ^ y,
+      ~x, y & x}; //results with this variant
+
+    if(z[5] != z[6] + z[4] || (y | x) != (y ^ x) + z[8])
+      result = false;
+
+    bool same = true; //whether the results match those of scalar
+
+    for(uint32_t i=0; i<n; i++){
+      if(v == variants[0])expected[i] = z[i];
+      else same = same && z[i] == expected[i];
+    } //for
+
+    printf("%-7s %s\n", v, same? "agrees": "**** disagrees ****");
+    result = result && same;
+  } //for
+
+  set_kernels(kernels.c_str());
+
+  ReportTestResult(result);
+} //TestKernels
+
+/// \brief Test modular powers.
+///
+/// Test the modular power function and print the result to stdout. The
+/// modulus must be prime. The tests performed are that
+/// \f$x^k \bmod p\f$ agrees with powx() for small k, that
+/// \f$x^{p-1} \bmod p = 1\f$ and \f$x^p \bmod p = x\f$ (Fermat's little
+/// theorem), and that \f$x^{a+b} = x^a x^b\f$ modulo both p and the even
+/// number 2p, which takes the slower path.
+///
+/// \param p A prime modulus.
+
+void TestPowMod(const uintx_t& p){
+  printf("Modular power test: Fermat's little theorem and x^(a+b) = x^a*x^b\n");
+  printf("p has %u bits\n", log2x(p) + 1);
+  bool result = true;
+
+  const uintx_montgomery mont(p); //Montgomery context
+  const uintx_t a = p/3, b = (p >> 5) + 12345; //exponents
+
+  for(uint32_t i=2; i<50; i+=7){
+    const uintx_t x = powx(i, 100) + i; //base
+    const uintx_t m = 2*p; //even modulus
+
+    for(uint32_t k=0; k<40; k+=3)
+      if(powmodx(x, k, p) != powx(x%p, k)%p || powmodx(x, k, m) != powx(x%m, k)%m)
+        result = false;
+
+    if(powmodx(x, p - 1, p) != 1 || mont.pow(x, p) != x%p)
+      result = false;
+
+    if(powmodx(x, a + b, p) != powmodx(x, a, p)*powmodx(x, b, p)%p ||
+      powmodx(x, a + b, m) != powmodx(x, a, m)*powmodx(x, b, m)%m)
+        result = false;
+  } //for
+
+  if(powmodx(p, a, p) != 0 || powmodx(a, 0, p) != 1 || powmodx(a, b, 1) != 0 ||
+    powmodx(a, b, 0) != uintx_t::NaN || powmodx(uintx_t::NaN, b, p) != uintx_t::NaN ||
+    uintx_montgomery(2*p).pow(a, b) != uintx_t::NaN)
+      result = false;
+
+  ReportTestResult(result);
+} //TestPowMod
+
+/// \brief Test residues.
+///
+/// Test the residue operators and print the result to stdout. The tests
+/// performed are that sums, differences, products, and squares of residues
+/// agree with the uintx_t operators followed by remainder, that the product
+/// of a residue and its inverse is one, that a residue that is not coprime
+/// to the modulus has no inverse, and that mixing residues with different
+/// contexts gives NaN.
+///
+/// \param m An odd modulus.
+/// \param x A number much larger than the modulus.
+
+void TestResidue(const uintx_t& m, const uintx_t& x){
+  printf("Residue test: residue operators agree with uintx_t operators mod m\n");
+  printf("m has %u bits\n", log2x(m) + 1);
+  bool result = true;
+
+  const uintx_montgomery mont(m), mont3(3*m); //Montgomery contexts
+  const modx_t one(mont, 1); //one
+  modx_t c(mont); //accumulator
+
+  for(int32_t k=0; k<=int32_t(log2x(x)); k+=61){
+    const uintx_t y = x >> k, z = (x >> (k/2)) + 1; //operands
+    const uintx_t y0 = y%m, z0 = z%m; //reduced operands
+    const modx_t a(mont, y), b(mont, z); //residues
+
+    if(to_uintx(a) != y0 || to_uintx(a + b) != (y0 + z0)%m ||
+      to_uintx(a - b) != (y0 + m - z0)%m || to_uintx(a*b) != y0*z0%m ||
+      to_uintx(a*a) != y0*y0%m)
+        result = false;
+
+    c = a;
+    c *= c;
+    c -= b;
+    c += one;
+    if(to_uintx(c) != (y0*y0%m + m - z0 + 1)%m)result = false;
+
+    if(gcdx(y0, m) == 1 && (a*invx(a) != one || invx(invx(a)) != a))
+      result = false;
+
+    if(!invx(modx_t(mont3, 3*y)).is_nan())
+      result = false;
+  } //for
+
+  if(!invx(modx_t(mont)).is_nan() || !(one + modx_t(mont3, 1)).is_nan() ||
+    !modx_t().is_nan() || !modx_t(uintx_montgomery(2*m), 1).is_nan() ||
+    to_uintx(modx_t(mont, uintx_t::NaN)) != uintx_t::NaN)
+      result = false;
+
+  ReportTestResult(result);
+} //TestResidue
+
 /// \brief Test powers.
 ///
 /// Test the extensible unsigned integer power function and print the
@@ -203,6 +730,226 @@ void TestPrint(const uintx_t& x){
   printf("\n");
 } //TestPrint
 
+/// \brief Test decimal conversion.
+///
+/// Test the conversion of extensible unsigned integers to decimal strings
+/// and print the result to stdout. The tests performed are that
+/// to_string() agrees with nine digits at a time peeled off using the
+/// remainder and division operators, that \f$10^k\f$ and \f$10^k - 1\f$
+/// give a one followed by k zeros and k nines, respectively, for k on both
+/// sides of the points at which the conversion splits numbers, and that
+/// to_commastring() puts the commas in the right places.
+///
+/// \param x An extensible unsigned integer.
+
+void TestDecimal(const uintx_t& x){
+  printf("Decimal conversion test: to_string(x) against 9 digits at a time\n");
+  bool result = true;
+
+  std::string expected; //x in decimal, least significant digit first
+  uintx_t y(x); //remaining digits
+
+  while(!y.is_zero()){
+    uint32_t r = to_uint32(y%1000000000); //next 9 digits
+
+    for(uint32_t i=0; i<9; i++){
+      expected += char('0' + r%10);
+      r /= 10;
+    } //for
+
+    y /= 1000000000;
+  } //while
+
+  while(expected.size() > 1 && expected.back() == '0')
+    expected.pop_back(); //remove leading zeros
+
+  std::reverse(expected.begin(), expected.end());
+
+  const std::string s = to_string(x); //decimal string to test
+  if(s != expected)result = false;
+
+  for(uint32_t k=1; k<2000; k+=(k < 40? 1: 37)){
+    const uintx_t p = powx(10, k); //10^k
+
+    if(to_string(p) != "1" + std::string(k, '0') ||
+      to_string(p - 1) != std::string(k, '9'))
+        result = false;
+  } //for
+
+  std::string commas = to_commastring(x); //with commas
+  commas.erase(std::remove(commas.begin(), commas.end(), ','), commas.end());
+
+  if(commas != s || to_commastring(uintx_t(1234567)) != "1,234,567" ||
+    to_commastring(uintx_t(123456)) != "123,456" || to_commastring(uintx_t(0)) != "0")
+      result = false;
+
+  printf("x has %u decimal digits\n", (uint32_t)s.size());
+  printf("first 40: %s\n", s.substr(0, 40).c_str());
+  printf("last 40:  %s\n", s.substr(s.size() - 40).c_str());
+
+  ReportTestResult(result);
+} //TestDecimal
+
+/// \brief Test conversion from strings.
+///
+/// Test the conversion of strings in various bases to extensible unsigned
+/// integers and print the result to stdout. The tests performed are that
+/// from_string() gives back the operand from its decimal and hex strings,
+/// with and without leading zeros, that it reads small numbers in bases
+/// from 2 to 36 correctly, and that it gives NaN for a bad base, an empty
+/// string, or a character that is not a digit in the base.
+///
+/// \param x An extensible unsigned integer.
+
+void TestFromString(const uintx_t& x){
+  printf("String conversion test: from_string(to_string(x)) = x\n");
+  bool result = true;
+
+  const std::string s = to_string(x); //decimal string
+
+  if(from_string(s) != x || from_string("000" + s) != x ||
+    from_string(to_hexstring(x), 16) != x)
+      result = false;
+
+  for(uint32_t base=2; base<=36; base++){
+    const std::string digits = "0123456789abcdefghijklmnopqrstuvwxyz"; //all digits
+    uintx_t expected(0); //value of the first base digits in the base
+
+    for(uint32_t i=0; i<base; i++){
+      expected *= base;
+      expected += i;
+    } //for
+
+    if(from_string(digits.substr(0, base), base) != expected)
+      result = false;
+  } //for
+
+  if(from_string("ZZ", 36) != 1295 || from_string("0") != 0 ||
+    from_string("7", 8) != 7 || from_string("101", 2) != 5)
+      result = false;
+
+  if(from_string("12a") != uintx_t::NaN || from_string("") != uintx_t::NaN ||
+    from_string("2", 2) != uintx_t::NaN || from_string("1", 37) != uintx_t::NaN)
+      result = false;
+
+  printf("x has %u decimal digits\n", (uint32_t)s.size());
+
+  ReportTestResult(result);
+} //TestFromString
+
+/// \brief Test conversion to strings in other bases.
+///
+/// Test the conversion of extensible unsigned integers to strings in bases
+/// from 2 to 36 and print the result to stdout. The tests performed are
+/// that from_string() gives back the operand from its string in each base,
+/// that the strings have no leading zeros, that small numbers give the
+/// right digits, and that a base out of range gives an empty string.
+///
+/// \param x An extensible unsigned integer.
+
+void TestBases(const uintx_t& x){
+  printf("Base conversion test: from_string(to_string(x, b), b) = x\n");
+  bool result = true;
+
+  for(uint32_t base=2; base<=36; base++){
+    const std::string s = to_string(x, base); //x in this base
+    if(s[0] == '0' || from_string(s, base) != x)result = false;
+  } //for
+
+  if(to_string(uintx_t(1295), 36) != "ZZ" || to_string(uintx_t(5), 2) != "101" ||
+    to_bitstring(uintx_t(0)) != "0" || to_string(uintx_t(0), 7) != "0" ||
+    to_string(uintx_t(255), 16) != to_hexstring(uintx_t(255)) ||
+    to_string(x, 1) != "" || to_string(x, 37) != "")
+      result = false;
+
+  printf("x in base 36 = %s\n", to_string(x, 36).substr(0, 60).c_str());
+  printf("x in base 32 = %s\n", to_string(x, 32).substr(0, 60).c_str());
+  printf("x in base 7  = %s\n", to_string(x, 7).substr(0, 60).c_str());
+
+  ReportTestResult(result);
+} //TestBases
+
+/// \brief Test string conversion on several threads.
+///
+/// Test conversion of extensible unsigned integers to and from strings in
+/// several bases on several threads at the same time and print the result
+/// to stdout. The test performed is that every thread gets the same
+/// strings, and the same numbers back from them, as a single thread does.
+/// Each thread starts from an empty cache of powers of the base, so the
+/// threads build their caches at the same time.
+///
+/// \param x An extensible unsigned integer.
+
+void TestThreads(const uintx_t& x){
+  printf("Thread test: to_string(x, b) and from_string on 4 threads at once\n");
+
+  const uint32_t bases[] = {10, 7, 36}; //bases to convert in
+  std::vector<std::string> expected; //strings from this thread
+
+  for(uint32_t base: bases)
+    expected.push_back(to_string(x, base));
+
+  bool ok[4] = {true, true, true, true}; //result of each thread
+  std::vector<std::thread> threads; //threads
+
+  for(uint32_t i=0; i<4; i++)
+    threads.emplace_back([&, i](){
+      for(uint32_t j=0; j<3; j++){
+        const std::string s = to_string(x, bases[j]); //x in this base
+        if(s != expected[j] || from_string(s, bases[j]) != x)ok[i] = false;
+      } //for
+    });
+
+  for(std::thread& t: threads)
+    t.join();
+
+  printf("x has %u decimal digits\n", (uint32_t)expected[0].size());
+
+  ReportTestResult(ok[0] && ok[1] && ok[2] && ok[3]);
+} //TestThreads
+
+/// \brief Test hex conversion.
+///
+/// Test the conversion of extensible unsigned integers to and from hex
+/// strings and print the result to stdout. The tests performed are that
+/// the string constructor gives back \f$x\f$ and its leading words from
+/// to_hexstring(), with and without 0x, leading zeros, and lower case
+/// letters, that to_hexstring() agrees with to_string() in base 16, and
+/// that a non-hex character anywhere in the string gives NaN.
+///
+/// \param x An extensible unsigned integer.
+
+void TestHex(const uintx_t& x){
+  printf("Hex conversion test: uintx_t(to_hexstring(x)) = x\n");
+  bool result = true;
+
+  const std::string s = to_hexstring(x); //hex string
+
+  for(size_t n=1; n<=s.size(); n+=(n < 40? 1: 13)){ //leading digits
+    const std::string t = s.substr(0, n); //first n digits
+    const uintx_t y = x >> int32_t(4*(s.size() - n)); //their value
+    std::string lower(t); //in lower case
+    std::transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+
+    if(uintx_t(t) != y || uintx_t("0x" + t) != y || uintx_t("000" + t) != y ||
+      uintx_t(lower) != y || to_hexstring(y) != t || to_string(y, 16) != t)
+        result = false;
+
+    for(size_t i: {size_t(0), n/2, n - 1}){ //put a bad character here
+      std::string bad(t);
+      bad[i] = "gG x-"[i%5];
+      if(uintx_t(bad) != uintx_t::NaN)result = false;
+    } //for
+  } //for
+
+  if(uintx_t("0") != 0 || uintx_t("0x") != 0 || to_hexstring(uintx_t(0)) != "0")
+    result = false;
+
+  printf("x = %s...\n", s.substr(0, 60).c_str());
+
+  ReportTestResult(result);
+} //TestHex
+
 /// \brief Test square roots.
 ///
 /// Test the extensible unsigned integer square root function and print the
@@ -235,9 +982,10 @@ void TestSqrt(const uintx_t& x){
 /// \brief Main.
 ///
 /// Test extensible unsigned integer printing, square roots, division and
-/// remainder, Fibonacci number generation, and greatest common divisor
-/// on hard-coded parameters. The results are printed to stdout along with
-/// the results of the calculations so the user can check them by eye.
+/// remainder, Fibonacci number generation, greatest common divisor, and
+/// multiplication on hard-coded parameters. The results are printed to
+/// stdout along with the results of the calculations so the user can check
+/// them by eye.
 ///
 /// \return 0 (what could possibly go wrong?)
 
@@ -246,10 +994,36 @@ int main(){
 
   TestDivMod("0x3DD8FD1EB259B9D5AD5B3487472222EC4F163435177E42A4DC40",
     "0x1CB6EBD33066A30F74");
+  TestDivMod("0xFFFFFFFEFFFFFFFFFFFFFFFE00000000", "0x10000000000000001");
+  TestRecursiveDivision(fibx(200000), fibx(90000));
+  TestRecursiveDivision(factorialx(20000), (fibx(30000) << 17) - 1);
+  TestDivisor(fibx(20000), fibx(1500));
+  TestDivisor(fibx(20000), fibx(12000));
   TestFibonacci(250);
+  TestBuiltin(fibx(1000));
+  TestCapacity(100);
+  TestWords();
+  TestShift(fibx(500));
   TestGcd("0x766C1042499184CAAB4A80602433449A", "0x21C3677C82B40000");
+  TestLargeGcd(fibx(300000), fibx(200000));
+  TestLargeGcd(factorialx(5000), fibx(60000) + 1);
+  TestMultiply(fibx(50000), fibx(60000));
+  TestMultiply(fibx(100000), factorialx(1000));
+  TestMultiply(fibx(1000000), fibx(900000));
+  TestSquare(fibx(60000));
+  TestSquare(fibx(1000000));
+  TestKernels(fibx(4000), factorialx(300));
   TestPower("0x8B99E6BDDEC48");
+  TestPowMod(exp2x(521) - 1);
+  TestPowMod(exp2x(2203) - 1);
+  TestResidue(exp2x(521) - 1, fibx(20000));
+  TestResidue(fibx(3000) | 1, fibx(20000));
   TestSqrt(powx(0xFFFFFFFFF, 5)*fibx(100));
+  TestDecimal(fibx(40000));
+  TestFromString(fibx(40000));
+  TestBases(fibx(20000));
+  TestThreads(fibx(400000));
+  TestHex(fibx(3000));
 
   printf("%u tests passed out of %u\n", g_nPassCount, g_nTestCount);
 
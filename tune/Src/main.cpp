@@ -0,0 +1,214 @@
+/// \file main.cpp
+/// \brief A program that tunes the uintx_t algorithm thresholds.
+
+#include <stdio.h>
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <string>
+#include <functional>
+
+#include "uintx_t.h"
+#include "uintx_tune.h"
+
+std::mt19937 g_cPRNG; ///< Pseudo-random number generator.
+
+const double MIN_TIME = 0.02; ///< Minimum time to spend on each measurement, in seconds.
+const uint32_t RUN_LENGTH = 3; ///< Number of consecutive wins needed for a crossover.
+
+//////////////////////////////////////////////////////////////////////////////
+// Helper functions
+
+/// \brief Random extensible unsigned integer.
+///
+/// Generate a pseudo-random extensible unsigned integer with a given number
+/// of words of type `word_t`, which is the unit that the thresholds in
+/// uintx_tune.h count. The hex string is built from 32-bit chunks, several
+/// to a word when words are 64-bit. The most significant chunk is guaranteed
+/// to be non-zero.
+///
+/// \param n Number of words.
+/// \return A pseudo-random extensible unsigned integer with n words.
+
+uintx_t RandomUintx(uint32_t n){
+  std::string s; //hex string
+  char buffer[16]; //buffer for one 32-bit chunk
+  const uint32_t chunks = n*(uint32_t)sizeof(word_t)/4; //number of 32-bit chunks
+
+  for(uint32_t i=0; i<chunks; i++){
+    uint32_t chunk = g_cPRNG(); //next chunk
+    if(i == 0 && chunk == 0)chunk = 1; //most significant chunk must be non-zero
+    snprintf(buffer, sizeof(buffer), "%08X", chunk);
+    s += buffer;
+  } //for
+
+  return uintx_t(s);
+} //RandomUintx
+
+/// \brief Time a function.
+///
+/// Call a function repeatedly until at least MIN_TIME seconds have elapsed
+/// and report the average time per call.
+///
+/// \param f Function to be timed.
+/// \return Average time per call in seconds.
+
+double Time(const std::function<void()>& f){
+  typedef std::chrono::steady_clock clock; //shorthand
+  const auto start = clock::now(); //start time
+  uint32_t count = 0; //number of calls
+  double elapsed = 0; //elapsed time in seconds
+
+  do{
+    f();
+    count++;
+    elapsed = std::chrono::duration<double>(clock::now() - start).count();
+  }while(elapsed < MIN_TIME);
+
+  return elapsed/count;
+} //Time
+
+/// \brief Find a crossover point.
+///
+/// Find the smallest operand size at which one algorithm becomes faster than
+/// another. Operand sizes are tried in increasing order from a lower
+/// bound to an upper bound, and the crossover is taken to be the first
+/// of RUN_LENGTH consecutive sizes at which the new algorithm wins.
+/// The threshold variable is set to the operand size to time the new
+/// algorithm at the top level only, and to one more than the operand
+/// size to time the old algorithm.
+///
+/// \param name Name of the threshold, for printing.
+/// \param threshold [in, out] Threshold variable, set to the crossover.
+/// \param lo Smallest operand size in words.
+/// \param hi Largest operand size in words.
+/// \param step Distance between operand sizes.
+/// \param op Operation to be timed on a pair of operands.
+/// \return The crossover point in words.
+
+uint32_t Crossover(const char* name, uint32_t& threshold, uint32_t lo,
+  uint32_t hi, uint32_t step,
+  const std::function<void(const uintx_t&, const uintx_t&)>& op)
+{
+  printf("%s\n", name);
+  printf("%8s %12s %12s\n", "n", "old", "new");
+
+  uint32_t result = hi; //crossover point
+  uint32_t wins = 0; //consecutive wins for new algorithm
+
+  for(uint32_t n=lo; n<=hi && wins<RUN_LENGTH; n+=step){
+    const uintx_t y = RandomUintx(n);
+    const uintx_t z = RandomUintx(n);
+
+    threshold = n + 1;
+    const double t0 = Time([&](){op(y, z);});
+    threshold = n;
+    const double t1 = Time([&](){op(y, z);});
+
+    printf("%8u %10.3fus %10.3fus\n", n, 1e6*t0, 1e6*t1);
+
+    if(t1 < t0){
+      if(wins++ == 0)
+        result = n;
+    } //if
+
+    else wins = 0;
+  } //for
+
+  threshold = result;
+  printf("%s = %u\n\n", name, result);
+
+  return result;
+} //Crossover
+
+/// \brief Write thresholds.
+///
+/// Write the tuned thresholds to a header file in a format that can be
+/// used to compile the uintx_t library. See uintx_tune.h for details.
+///
+/// \param fname Name of header file.
+
+void WriteThresholds(const char* fname){
+  FILE* output = fopen(fname, "wt");
+
+  if(output == nullptr)
+    printf("Cannot open %s for writing\n", fname);
+
+  else{
+    fprintf(output, "/// \\file %s\n", fname);
+    fprintf(output, "/// \\brief Thresholds measured by the tune program.\n\n");
+
+    fprintf(output, "#define UINTX_KARATSUBA_THRESHOLD %u\n", g_nKaratsubaThreshold);
+    fprintf(output, "#define UINTX_TOOM3_THRESHOLD %u\n", g_nToom3Threshold);
+    fprintf(output, "#define UINTX_NTT_THRESHOLD %u\n", g_nNTTThreshold);
+    fprintf(output, "#define UINTX_SQR_KARATSUBA_THRESHOLD %u\n", g_nSqrKaratsubaThreshold);
+    fprintf(output, "#define UINTX_SQR_TOOM3_THRESHOLD %u\n", g_nSqrToom3Threshold);
+    fprintf(output, "#define UINTX_SQR_NTT_THRESHOLD %u\n", g_nSqrNTTThreshold);
+    fprintf(output, "#define UINTX_BZ_THRESHOLD %u\n", g_nBZThreshold);
+    fprintf(output, "#define UINTX_GCD_THRESHOLD %u\n", g_nGCDThreshold);
+
+    fclose(output);
+    printf("Thresholds written to %s\n", fname);
+  } //else
+} //WriteThresholds
+
+//////////////////////////////////////////////////////////////////////////////
+// Main
+
+/// \brief Main.
+///
+/// Measure the crossover points between the multiplication algorithms,
+/// between the squaring algorithms, between the division algorithms, and
+/// between the gcd algorithms on the host, print them to stdout, and write them to a header file.
+///
+/// \return 0 (what could possibly go wrong?)
+
+int main(){
+  auto multiply = [](const uintx_t& y, const uintx_t& z){
+    const uintx_t x = y*z;
+  }; //multiply
+
+  auto square = [](const uintx_t& y, const uintx_t&){
+    const uintx_t x = y*y;
+  }; //square
+
+  auto divide = [](const uintx_t& y, const uintx_t& z){
+    const uintx_t x = ((y << int32_t(log2x(z) + 1)) + z)/z;
+  }; //divide
+
+  auto gcd = [](const uintx_t& y, const uintx_t& z){
+    const uintx_t x = gcdx(y, z);
+  }; //gcd
+
+  g_nToom3Threshold = UINT32_MAX; //no Toom-3 while tuning Karatsuba
+  const uint32_t k = Crossover("Karatsuba threshold",
+    g_nKaratsubaThreshold, 4, 200, 2, multiply);
+
+  g_nNTTThreshold = UINT32_MAX; //no NTT while tuning Toom-3
+  const uint32_t t = Crossover("Toom-3 threshold",
+    g_nToom3Threshold, std::max(3*k, 5U), 1000, 8, multiply);
+
+  Crossover("NTT threshold",
+    g_nNTTThreshold, t, 20000, 256, multiply);
+
+  g_nSqrToom3Threshold = UINT32_MAX; //no Toom-3 while tuning Karatsuba
+  const uint32_t sk = Crossover("Karatsuba squaring threshold",
+    g_nSqrKaratsubaThreshold, 4, 300, 2, square);
+
+  g_nSqrNTTThreshold = UINT32_MAX; //no NTT while tuning Toom-3
+  const uint32_t st = Crossover("Toom-3 squaring threshold",
+    g_nSqrToom3Threshold, std::max(3*sk, 5U), 1200, 8, square);
+
+  Crossover("NTT squaring threshold",
+    g_nSqrNTTThreshold, st, 20000, 256, square);
+
+  Crossover("Burnikel-Ziegler division threshold",
+    g_nBZThreshold, 4, 300, 4, divide);
+
+  Crossover("Half-GCD threshold",
+    g_nGCDThreshold, 20, 400, 10, gcd);
+
+  WriteThresholds("uintx_thresholds.h");
+
+  return 0; //what could possibly go wrong?
+} //main
@@ -0,0 +1,336 @@
+/// \file modx_t.cpp
+/// \brief Implementation of the residue class.
+
+#include <algorithm>
+#include <vector>
+
+#include "modx_t.h"
+
+/// Get scratch space for the word-level Montgomery functions. Each thread
+/// has its own buffer, which grows to the largest amount needed by any
+/// context used on that thread and is then reused, so that residue
+/// arithmetic need not allocate memory and residues bound to the same
+/// context may be used on different threads.
+/// \param c Montgomery context.
+/// \return Scratch space of c.scratch_size() words.
+
+static word_t* scratch(const uintx_montgomery& c){
+  static thread_local std::vector<word_t> s; //scratch space for this thread
+
+  if(s.size() < c.scratch_size())
+    s.resize(c.scratch_size());
+
+  return s.data();
+} //scratch
+
+/////////////////////////////////////////////////////////////////////////////
+// Constructors and destructors.
+
+#pragma region constructors
+
+/// Default constructor. The residue is not bound to a context and is NaN
+/// until something is assigned to it.
+
+modx_t::modx_t(){
+} //constructor
+
+/// Constructor. The residue is bound to a context and set to zero. It is
+/// NaN if the context's modulus is not odd.
+/// \param c Montgomery context.
+
+modx_t::modx_t(const uintx_montgomery& c){
+  bind(&c);
+
+  if(!m_bNaN)
+    std::fill(m_pData, m_pData + c.size(), 0);
+} //constructor
+
+/// Constructor. The residue is bound to a context and set to a number,
+/// which is reduced modulo the modulus. It is NaN if the number is NaN or
+/// the context's modulus is not odd.
+/// \param c Montgomery context.
+/// \param x Number.
+
+modx_t::modx_t(const uintx_montgomery& c, const uintx_t& x){
+  bind(&c);
+
+  if(x == uintx_t::NaN)
+    m_bNaN = true;
+
+  else if(!m_bNaN)
+    c.load(m_pData, x, scratch(c));
+} //constructor
+
+/// Copy constructor.
+/// \param x Residue to copy.
+
+modx_t::modx_t(const modx_t& x){
+  *this = x;
+} //constructor
+
+/// Move constructor. The moved-from residue is left NaN and unbound.
+/// \param x Residue to move.
+
+modx_t::modx_t(modx_t&& x){
+  std::swap(m_pContext, x.m_pContext);
+  std::swap(m_pData, x.m_pData);
+  std::swap(m_bNaN, x.m_bNaN);
+} //constructor
+
+/// Destructor.
+
+modx_t::~modx_t(){
+  delete [] m_pData;
+} //destructor
+
+#pragma endregion constructors
+
+/////////////////////////////////////////////////////////////////////////////
+// Private helper functions.
+
+#pragma region helpers
+
+/// Bind to a context. The array of words is reallocated only if the new
+/// context's residues are a different size. The value is not set, but
+/// the residue is NaN if the context's modulus is not odd.
+/// \param c Pointer to a Montgomery context.
+
+void modx_t::bind(const uintx_montgomery* c){
+  const uint32_t n = m_pContext? m_pContext->size(): 0; //current size
+
+  if(c->size() != n){
+    delete [] m_pData;
+    m_pData = c->size() > 0? new word_t[c->size()]: nullptr;
+  } //if
+
+  m_pContext = c;
+  m_bNaN = c->size() == 0;
+} //bind
+
+/// Test whether a residue can be combined with this one, that is, neither
+/// is NaN and both are bound to the same context.
+/// \param x Residue.
+/// \return true if the residues are compatible.
+
+bool modx_t::compatible(const modx_t& x) const{
+  return !m_bNaN && !x.m_bNaN && m_pContext == x.m_pContext;
+} //compatible
+
+#pragma endregion helpers
+
+/////////////////////////////////////////////////////////////////////////////
+// Assignment operators.
+
+#pragma region assignment
+
+/// Assignment operator. This does not allocate memory if the residue is
+/// already bound to a context of the same size.
+/// \param x Operand.
+/// \return Reference after assignment.
+
+modx_t& modx_t::operator=(const modx_t& x){
+  if(this != &x){ //protect against self assignment
+    if(x.m_pContext == nullptr){
+      delete [] m_pData;
+      m_pData = nullptr;
+      m_pContext = nullptr;
+      m_bNaN = true;
+    } //if
+
+    else{
+      bind(x.m_pContext);
+      m_bNaN = x.m_bNaN;
+
+      if(m_pData)
+        std::copy(x.m_pData, x.m_pData + m_pContext->size(), m_pData);
+    } //else
+  } //if
+
+  return *this;
+} //operator=
+
+/// Move assignment operator. The operand gets this residue's old storage.
+/// \param x Operand.
+/// \return Reference after assignment.
+
+modx_t& modx_t::operator=(modx_t&& x){
+  std::swap(m_pContext, x.m_pContext);
+  std::swap(m_pData, x.m_pData);
+  std::swap(m_bNaN, x.m_bNaN);
+
+  return *this;
+} //operator=
+
+#pragma endregion assignment
+
+/////////////////////////////////////////////////////////////////////////////
+// Arithmetic operators.
+
+#pragma region arithmetic
+
+/// Add to.
+/// \param y Operand.
+/// \return Reference after addition.
+
+modx_t& modx_t::operator+=(const modx_t& y){
+  if(compatible(y))
+    m_pContext->add(m_pData, m_pData, y.m_pData);
+  else m_bNaN = true;
+
+  return *this;
+} //operator+=
+
+/// Subtract from.
+/// \param y Operand.
+/// \return Reference after subtraction.
+
+modx_t& modx_t::operator-=(const modx_t& y){
+  if(compatible(y))
+    m_pContext->sub(m_pData, m_pData, y.m_pData);
+  else m_bNaN = true;
+
+  return *this;
+} //operator-=
+
+/// Multiply by. Multiplying a residue by itself uses squaring.
+/// \param y Operand.
+/// \return Reference after multiplication.
+
+modx_t& modx_t::operator*=(const modx_t& y){
+  if(!compatible(y))
+    m_bNaN = true;
+
+  else if(this == &y)
+    m_pContext->sqr(m_pData, m_pData, scratch(*m_pContext));
+
+  else m_pContext->mul(m_pData, m_pData, y.m_pData, scratch(*m_pContext));
+
+  return *this;
+} //operator*=
+
+/// Replace by the inverse modulo the modulus.
+/// \return Reference after inversion, which is NaN if the residue is not
+/// coprime to the modulus.
+
+modx_t& modx_t::invert(){
+  if(!m_bNaN &&
+    !m_pContext->inverse(m_pData, m_pData, scratch(*m_pContext)))
+      m_bNaN = true;
+
+  return *this;
+} //invert
+
+/// Addition.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return x + y modulo the modulus.
+
+modx_t operator+(const modx_t& x, const modx_t& y){
+  modx_t z(x); //result
+  z += y;
+
+  return z;
+} //operator+
+
+/// Subtraction.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return x - y modulo the modulus.
+
+modx_t operator-(const modx_t& x, const modx_t& y){
+  modx_t z(x); //result
+  z -= y;
+
+  return z;
+} //operator-
+
+/// Multiplication.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return x times y modulo the modulus.
+
+modx_t operator*(const modx_t& x, const modx_t& y){
+  modx_t z(x); //result
+  z *= &x == &y? z: y;
+
+  return z;
+} //operator*
+
+/// Inverse.
+/// \param x Operand.
+/// \return Inverse of x modulo the modulus, or NaN if there is none.
+
+modx_t invx(const modx_t& x){
+  modx_t z(x); //result
+  z.invert();
+
+  return z;
+} //invx
+
+#pragma endregion arithmetic
+
+/////////////////////////////////////////////////////////////////////////////
+// Comparison operators.
+
+#pragma region comparison
+
+/// Equal to. Residues in Montgomery form are always fully reduced, so equal
+/// residues have equal words. Two NaNs are equal, as for uintx_t.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true if x is equal to y.
+
+const bool operator==(const modx_t& x, const modx_t& y){
+  if(x.m_bNaN || y.m_bNaN)
+    return x.m_bNaN && y.m_bNaN;
+
+  return x.m_pContext == y.m_pContext &&
+    std::equal(x.m_pData, x.m_pData + x.m_pContext->size(), y.m_pData);
+} //operator==
+
+/// Not equal to.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true if x is not equal to y.
+
+const bool operator!=(const modx_t& x, const modx_t& y){
+  return !(x == y);
+} //operator!=
+
+#pragma endregion comparison
+
+/////////////////////////////////////////////////////////////////////////////
+// Miscellaneous.
+
+#pragma region miscellaneous
+
+/// Get the context that the residue is bound to.
+/// \return Pointer to the context, or nullptr if there is none.
+
+const uintx_montgomery* modx_t::context() const{
+  return m_pContext;
+} //context
+
+/// NaN test.
+/// \return true if the residue is NaN.
+
+bool modx_t::is_nan() const{
+  return m_bNaN;
+} //is_nan
+
+/// Convert to an extensible unsigned integer, taking it out of Montgomery
+/// form.
+/// \param x Residue.
+/// \return The residue as a number less than the modulus, or NaN.
+
+uintx_t to_uintx(const modx_t& x){
+  if(x.m_bNaN)
+    return uintx_t::NaN;
+
+  uintx_t z; //result
+  x.m_pContext->store(z, x.m_pData, scratch(*x.m_pContext));
+
+  return z;
+} //to_uintx
+
+#pragma endregion miscellaneous
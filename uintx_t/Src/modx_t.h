@@ -0,0 +1,77 @@
+/// \file modx_t.h
+/// \brief Declaration of the residue class.
+
+#if !defined(__modx_t__)
+#define __modx_t__
+
+#include "uintx_t.h"
+#include "uintx_montgomery.h"
+
+/// \brief The residue class.
+///
+/// A residue is a number modulo a fixed odd modulus, bound to a shared
+/// Montgomery context for that modulus (see uintx_montgomery.h), which
+/// must outlive it. It is kept in Montgomery form in an array of exactly
+/// as many words as the modulus, which is allocated when the residue is
+/// constructed and never changes size. The compound assignment operators,
+/// invert(), and assignment between residues of the same context
+/// therefore never allocate memory, nor does the Montgomery multiplication,
+/// which takes its scratch space from a buffer kept by each thread. The
+/// binary operators allocate only the array for their result.
+///
+/// Any operation on a NaN residue, on residues bound to different contexts,
+/// or the inverse of a residue that is not coprime to the modulus results
+/// in NaN. A residue constructed without a context is NaN.
+
+class modx_t{
+  private:
+    const uintx_montgomery* m_pContext = nullptr; ///< Montgomery context.
+    word_t* m_pData = nullptr; ///< Array of words in Montgomery form.
+    bool m_bNaN = true; ///< Not a number.
+
+    void bind(const uintx_montgomery*); ///< Bind to a context.
+    bool compatible(const modx_t&) const; ///< Same context and not NaN.
+
+  public:
+    modx_t(); ///< Constructor.
+    modx_t(const uintx_montgomery&); ///< Constructor.
+    modx_t(const uintx_montgomery&, const uintx_t&); ///< Constructor.
+    modx_t(const modx_t&); ///< Copy constructor.
+    modx_t(modx_t&&); ///< Move constructor.
+
+    ~modx_t(); ///< Destructor.
+
+    const uintx_montgomery* context() const; ///< Get the context.
+
+    //assignment operators
+
+    modx_t& operator=(const modx_t&); ///< Assignment.
+    modx_t& operator=(modx_t&&); ///< Move assignment.
+
+    //arithmetic operators
+
+    modx_t& operator+=(const modx_t&); ///< Add to.
+    modx_t& operator-=(const modx_t&); ///< Subtract from.
+    modx_t& operator*=(const modx_t&); ///< Multiply by.
+    modx_t& invert(); ///< Replace by inverse.
+
+    friend modx_t operator+(const modx_t&, const modx_t&); ///< Addition.
+    friend modx_t operator-(const modx_t&, const modx_t&); ///< Subtraction.
+    friend modx_t operator*(const modx_t&, const modx_t&); ///< Multiplication.
+    friend modx_t invx(const modx_t&); ///< Inverse.
+
+    //comparison operators
+
+    friend const bool operator==(const modx_t&, const modx_t&); ///< Equal to.
+    friend const bool operator!=(const modx_t&, const modx_t&); ///< Not equal to.
+
+    //miscellaneous
+
+    bool is_nan() const; ///< NaN test.
+
+    //type conversions
+
+    friend uintx_t to_uintx(const modx_t&); ///< To extensible unsigned integer.
+}; //modx_t
+
+#endif
@@ -0,0 +1,383 @@
+/// \file uintx_div.cpp
+/// \brief Implementation of the division kernels.
+///
+/// Division is done a word at a time by Knuth's Algorithm D (The Art of
+/// Computer Programming, Vol. 2, Section 4.3.1). Each word of the quotient
+/// is estimated from the top two words of the partial remainder and the top
+/// word of the divisor using double-word arithmetic. Normalizing the divisor so
+/// that its most significant bit is set guarantees that the estimate is
+/// never too small and, after a cheap correction using the next word of
+/// the divisor, is almost always exact. The estimate divides by the top
+/// word of the divisor using a precomputed reciprocal instead of a
+/// hardware division (Moller and Granlund, Improved Division by Invariant
+/// Integers, IEEE Transactions on Computers 60(2), 2011), which is much
+/// faster, and lets a divisor that is used many times be prepared once,
+/// see uintx_divisor.
+///
+/// Large divisors with large quotients are divided by the recursive method
+/// of Burnikel and Ziegler (Fast Recursive Division, MPI-I-98-1-022, 1998),
+/// in the form used by GMP. Half of the quotient is found by dividing the
+/// top half of the dividend by the top half of the divisor recursively, and
+/// is corrected by multiplying it by the bottom half of the divisor. Since
+/// the multiplications use the fast algorithms in uintx_mul.cpp, division
+/// takes about the time of a couple of multiplications instead of being
+/// quadratic.
+
+#include "uintx_div.h"
+#include "uintx_kernel.h"
+#include "uintx_mul.h"
+#include "uintx_tune.h"
+
+#include <algorithm>
+
+const uint32_t BITS_IN_WORD = 8*sizeof(word_t); ///< Number of bits in a word.
+const uint32_t DIVREM_LOCAL_WORDS = 16; ///< Largest divrem() scratch space kept on the stack, in words.
+
+uint32_t g_nBZThreshold = UINTX_BZ_THRESHOLD; ///< Burnikel-Ziegler threshold.
+
+/////////////////////////////////////////////////////////////////////////////
+// Division.
+
+#pragma region division
+
+/// Divide a double word by a normalized word using its reciprocal from
+/// reciprocal(). This takes two multiplications and a few corrections
+/// instead of a division.
+/// \param hi High word of the dividend, smaller than the divisor.
+/// \param lo Low word of the dividend.
+/// \param d Divisor, with its most significant bit set.
+/// \param inv Reciprocal of the divisor.
+/// \param r [out] Remainder.
+/// \return Quotient.
+
+static inline word_t div2by1(word_t hi, word_t lo, word_t d, word_t inv,
+  word_t& r)
+{
+  const dword_t p = (dword_t)inv*hi + (((dword_t)hi + 1) << BITS_IN_WORD) + lo;
+  word_t q = word_t(p >> BITS_IN_WORD); //quotient estimate
+  r = lo - q*d; //remainder estimate, modulo the radix
+
+  if(r > word_t(p)){ //estimate one too large
+    q--;
+    r += d;
+  } //if
+
+  if(r >= d){ //estimate one too small, which is rare
+    q++;
+    r -= d;
+  } //if
+
+  return q;
+} //div2by1
+
+/// Compute the reciprocal of a normalized word for div2by1(). This is
+/// \f$\lfloor (B^2 - 1)/d \rfloor - B\f$, where \f$B\f$ is the radix.
+/// \param d A word with its most significant bit set.
+/// \return Its reciprocal.
+
+word_t reciprocal(word_t d){
+  word_t r; //remainder, not used
+  return divw(~d, ~word_t(0), d, r);
+} //reciprocal
+
+/// Knuth's Algorithm D for an n-word dividend and an m-word divisor whose
+/// most significant bit is set. The dividend is replaced by the remainder.
+/// \param q [out] Quotient of n - m + 1 words, or nullptr if not wanted.
+/// \param u [in, out] Dividend of n + 1 words whose top word is smaller
+/// than the top word of the divisor. Remainder on exit, m words.
+/// \param n Number of words in the dividend, not counting the top word.
+/// \param v Normalized divisor of m words.
+/// \param m Number of words in the divisor, at least 2.
+/// \param inv Reciprocal of the top word of the divisor.
+
+static void divrem_knuth(word_t* q, word_t* u, uint32_t n,
+  const word_t* v, uint32_t m, word_t inv)
+{
+  const dword_t B = dword_t(1) << BITS_IN_WORD; //radix
+  const word_t v1 = v[m - 1]; //top word of divisor
+  const word_t v2 = v[m - 2]; //next word of divisor
+
+  for(uint32_t j=n-m+1; j-->0;){
+    //estimate the quotient word from the top two words of the remainder
+
+    dword_t qhat, rhat; //estimated quotient word and its remainder
+
+    if(u[j + m] < v1){ //estimate fits into a word
+      word_t w; //remainder
+      qhat = div2by1(u[j + m], u[j + m - 1], v1, inv, w);
+      rhat = w;
+    } //if
+
+    else{ //estimate is at least the radix
+      const dword_t num = ((dword_t)u[j + m] << BITS_IN_WORD) | u[j + m - 1];
+      qhat = num/v1;
+      rhat = num%v1;
+    } //else
+
+    //correct the estimate, after which it is at most one too large
+
+    while(qhat >= B || qhat*v2 > ((rhat << BITS_IN_WORD) | u[j + m - 2])){
+      --qhat;
+      rhat += v1;
+      if(rhat >= B)break;
+    } //while
+
+    //multiply and subtract, adding back in the rare case that the estimate
+    //was one too large
+
+    const word_t borrow = submul_1(u + j, v, m, word_t(qhat));
+
+    if(u[j + m] < borrow){ //went negative
+      --qhat;
+      u[j + m] += add_n(u + j, u + j, v, m) - borrow;
+    } //if
+
+    else u[j + m] -= borrow; //zero
+
+    if(q)q[j] = word_t(qhat);
+  } //for
+} //divrem_knuth
+
+/// Decide whether division by an n-word divisor should use Burnikel and
+/// Ziegler's recursive method. It needs at least 4 words so that both
+/// halves of the divisor have at least the 2 words that divrem_knuth()
+/// needs.
+/// \param n Number of words in the divisor.
+/// \return true if Burnikel-Ziegler division should be used.
+
+static bool UseBZ(uint32_t n){
+  return n >= std::max(g_nBZThreshold, 4U);
+} //UseBZ
+
+/// Divide a 2n-word number by a normalized n-word divisor with Knuth's
+/// Algorithm D. The top half of the dividend need not be smaller than the
+/// divisor, in which case the divisor is subtracted from it first and the
+/// quotient has an extra top bit.
+/// \param q [out] Quotient of n words, without its top bit.
+/// \param u [in, out] Dividend of 2n words. Remainder on exit, n words.
+/// \param v Normalized divisor of n words.
+/// \param n Number of words in the divisor, at least 2.
+/// \param inv Reciprocal of the top word of the divisor.
+/// \return Top bit of the quotient.
+
+static word_t divrem_base(word_t* q, word_t* u, const word_t* v, uint32_t n,
+  word_t inv)
+{
+  const word_t qh = cmp(u + n, v, n) >= 0? 1: 0; //top bit of quotient
+  if(qh > 0)sub_n(u + n, u + n, v, n);
+
+  divrem_knuth(q, u, 2*n - 1, v, n, inv);
+  return qh;
+} //divrem_base
+
+/// Divide a 2n-word number by a normalized n-word divisor recursively. The
+/// top half of the quotient is estimated by dividing the top 2h words of
+/// the dividend by the top h words of the divisor, where h is n/2 rounded
+/// up, and the product of the estimate and the bottom half of the divisor
+/// is subtracted from the remainder. The estimate is at most two too
+/// large, in which case the remainder goes negative and the divisor is
+/// added back. The bottom half of the quotient is found the same way from
+/// what remains. The top parts of the divisor that the recursive calls
+/// divide by have the same top word, and therefore the same reciprocal.
+/// \param q [out] Quotient of n words, without its top bit.
+/// \param u [in, out] Dividend of 2n words. Remainder on exit, n words.
+/// \param v Normalized divisor of n words.
+/// \param n Number of words in the divisor, at least 4.
+/// \param inv Reciprocal of the top word of the divisor.
+/// \param t Scratch space of n words.
+/// \return Top bit of the quotient.
+
+static word_t divrem_bz_n(word_t* q, word_t* u, const word_t* v, uint32_t n,
+  word_t inv, word_t* t)
+{
+  const word_t one = 1; //for decrementing the quotient
+  const uint32_t lo = n/2; //number of words in the bottom half of the quotient
+  const uint32_t hi = n - lo; //number of words in the top half of the quotient
+
+  //top half of the quotient
+
+  word_t qh = UseBZ(hi)? divrem_bz_n(q + lo, u + 2*lo, v + lo, hi, inv, t):
+    divrem_base(q + lo, u + 2*lo, v + lo, hi, inv);
+
+  mul(t, q + lo, hi, v, lo);
+  word_t borrow = sub_n(u + lo, u + lo, t, n);
+  if(qh > 0)borrow += sub_n(u + n, u + n, v, lo);
+
+  while(borrow > 0){ //estimate too large
+    qh -= sub(q + lo, q + lo, hi, &one, 1);
+    borrow -= add_n(u + lo, u + lo, v, n);
+  } //while
+
+  //bottom half of the quotient
+
+  const word_t ql = UseBZ(lo)? divrem_bz_n(q, u + hi, v + hi, lo, inv, t):
+    divrem_base(q, u + hi, v + hi, lo, inv);
+
+  mul(t, v, hi, q, lo);
+  borrow = sub_n(u, u, t, n);
+  if(ql > 0)borrow += sub_n(u + lo, u + lo, v, hi);
+
+  while(borrow > 0){ //estimate too large
+    sub(q, q, lo, &one, 1);
+    borrow -= add_n(u, u, v, n);
+  } //while
+
+  return qh;
+} //divrem_bz_n
+
+/// Burnikel and Ziegler's recursive division of an n-word dividend by an
+/// m-word divisor whose most significant bit is set. The dividend is padded
+/// with zero words at the top to a whole number of m-word blocks of
+/// quotient, and each block is found by divrem_bz_n() from the remainder
+/// so far and the next m words of the dividend.
+/// \param q [out] Quotient of n - m + 1 words, or nullptr if not wanted.
+/// \param u [in, out] Dividend of n + 1 words whose top word is smaller
+/// than the top word of the divisor. Remainder on exit, m words.
+/// \param n Number of words in the dividend, not counting the top word.
+/// \param v Normalized divisor of m words.
+/// \param m Number of words in the divisor, at least 4.
+/// \param inv Reciprocal of the top word of the divisor.
+
+static void divrem_bz(word_t* q, word_t* u, uint32_t n,
+  const word_t* v, uint32_t m, word_t inv)
+{
+  const uint32_t qn = n - m + 1; //number of words in the quotient
+  const uint32_t blocks = (qn + m - 1)/m; //number of m-word blocks of quotient
+
+  word_t* s = new word_t[(2*blocks + 2)*m]; //scratch space
+  word_t* a = s; //padded dividend, (blocks + 1)*m words
+  word_t* b = a + (blocks + 1)*m; //padded quotient, blocks*m words
+  word_t* t = b + blocks*m; //scratch space for divrem_bz_n(), m words
+
+  std::copy(u, u + n + 1, a);
+  std::fill(a + n + 1, b, 0);
+
+  for(uint32_t j=blocks; j-->0;) //for each block, most significant first
+    divrem_bz_n(b + j*m, a + j*m, v, m, inv, t);
+
+  std::copy(a, a + m, u); //remainder
+  if(q)std::copy(b, b + qn, q);
+
+  delete [] s;
+} //divrem_bz
+
+/// Divide an n-word number by a prepared m-word divisor, that is, one that
+/// has been shifted left so that its most significant bit is set. The
+/// dividend must have been shifted left by the same amount, which does not
+/// change the quotient. Divisors that are large enough, and leave a large
+/// enough quotient, are divided by divrem_bz(), and others by
+/// divrem_knuth(), or by div2by1() one word at a time for a single word.
+/// \param q [out] Quotient of n - m + 1 words, not overlapping the
+/// dividend, or nullptr if not wanted.
+/// \param u [in, out] Dividend of n + 1 words whose top word is smaller
+/// than the top word of the divisor. Remainder on exit, m words, still
+/// shifted.
+/// \param n Number of words in the dividend, not counting the top word.
+/// \param v Normalized divisor of m words.
+/// \param m Number of words in the divisor, at least 1.
+/// \param inv Reciprocal of the top word of the divisor, see reciprocal().
+
+void divrem_norm(word_t* q, word_t* u, uint32_t n, const word_t* v,
+  uint32_t m, word_t inv)
+{
+  if(m == 1){ //single-word divisor
+    word_t r = u[n]; //remainder so far
+
+    for(uint32_t j=n; j-->0;){
+      const word_t qj = div2by1(r, u[j], v[0], inv, r); //next quotient word
+      if(q)q[j] = qj;
+    } //for
+
+    u[0] = r;
+  } //if
+
+  else if(UseBZ(m) && UseBZ(n - m + 1))
+    divrem_bz(q, u, n, v, m, inv);
+
+  else divrem_knuth(q, u, n, v, m, inv);
+} //divrem_norm
+
+/// Divide an n-word number by an m-word number, where \f$n \geq m\f$ and
+/// the most significant word of the divisor is non-zero. Either the
+/// quotient or the remainder may be omitted by passing nullptr.
+/// \param q [out] Quotient of n - m + 1 words, not overlapping either
+/// operand, or nullptr.
+/// \param r [out] Remainder of m words, not overlapping either operand,
+/// or nullptr.
+/// \param a Dividend of n words.
+/// \param n Number of words in the dividend.
+/// \param b Divisor of m words.
+/// \param m Number of words in the divisor, at least 1.
+
+void divrem(word_t* q, word_t* r, const word_t* a, uint32_t n,
+  const word_t* b, uint32_t m)
+{
+  if(m == 1){ //single-word divisor
+    const word_t rem = divrem_1(q, a, n, b[0]);
+    if(r)r[0] = rem;
+    return;
+  } //if
+
+  //shift both operands left so that the top bit of the divisor is set,
+  //which does not change the quotient
+
+  const uint32_t d = nlz(b[m - 1]); //shift distance
+  word_t local[DIVREM_LOCAL_WORDS]; //scratch space for small operands
+  word_t* u = n + 1 + m <= DIVREM_LOCAL_WORDS? local:
+    new word_t[n + 1 + m]; //shifted dividend, n + 1 words
+  word_t* v = u + n + 1; //shifted divisor, m words
+
+  lshift(v, b, m, d);
+  u[n] = lshift(u, a, n, d);
+
+  divrem_norm(q, u, n, v, m, reciprocal(v[m - 1]));
+
+  if(r)rshift(r, u, m, d); //unshift the remainder
+
+  if(u != local)
+    delete [] u;
+} //divrem
+
+/// Divide an n-word number by an m-word number that is known to divide it
+/// exactly, by the method of Jebelean (An Algorithm for Exact Division,
+/// J. Symbolic Computation 15, 1993). The quotient is found from the least
+/// significant end, one word at a time, by multiplying the remaining
+/// dividend by the inverse of the divisor modulo the radix, so there is no
+/// quotient estimate to correct and only the n - m + 1 low words of the
+/// dividend are needed. Operands that are large enough for divrem_bz() are
+/// divided by divrem() instead, which is faster for them. If the division
+/// is not exact the quotient is meaningless.
+/// \param q [out] Quotient of n - m + 1 words, not overlapping either
+/// operand.
+/// \param a [in, out] Dividend of n words, \f$n \geq m\f$, which is
+/// destroyed.
+/// \param n Number of words in the dividend.
+/// \param d Odd divisor of m words whose most significant word is non-zero.
+/// \param m Number of words in the divisor, at least 1.
+
+void divexact(word_t* q, word_t* a, uint32_t n, const word_t* d, uint32_t m){
+  const uint32_t qn = n - m + 1; //number of words in the quotient
+
+  if(UseBZ(m) && UseBZ(qn)){
+    divrem(q, nullptr, a, n, d, m);
+    return;
+  } //if
+
+  const word_t inv = binvert(d[0]); //inverse of the divisor modulo the radix
+
+  for(uint32_t i=0; i<qn; i++){
+    const word_t qi = a[i]*inv; //clears word i of the dividend
+    const uint32_t k = std::min(m, qn - i); //words that affect the quotient
+    word_t c = submul_1(a + i, d, k, qi); //borrow
+
+    for(uint32_t j=i+k; c > 0 && j<qn; j++){ //propagate the borrow
+      const word_t t = a[j];
+      a[j] = t - c;
+      c = t < c;
+    } //for
+
+    q[i] = qi;
+  } //for
+} //divexact
+
+#pragma endregion division
@@ -0,0 +1,20 @@
+/// \file uintx_div.h
+/// \brief Declaration of the division kernels.
+///
+/// These functions operate directly on arrays of words stored
+/// least-significant first. They are used to implement the uintx_t
+/// division and remainder operators and are not part of the public
+/// interface. Division by a single word is done by divrem_1() in
+/// uintx_kernel.h.
+
+#if !defined(__uintx_div__)
+#define __uintx_div__
+
+#include "uintx_word.h"
+
+void divrem(word_t*, word_t*, const word_t*, uint32_t, const word_t*, uint32_t); ///< Division with remainder.
+void divrem_norm(word_t*, word_t*, uint32_t, const word_t*, uint32_t, word_t); ///< Division by a prepared divisor.
+word_t reciprocal(word_t); ///< Reciprocal of a normalized word.
+void divexact(word_t*, word_t*, uint32_t, const word_t*, uint32_t); ///< Exact division.
+
+#endif
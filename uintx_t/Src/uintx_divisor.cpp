@@ -0,0 +1,101 @@
+/// \file uintx_divisor.cpp
+/// \brief Implementation of the prepared divisor class.
+
+#include "uintx_divisor.h"
+#include "uintx_div.h"
+#include "uintx_kernel.h"
+
+/// Constructor. The divisor is shifted left so that its most significant
+/// bit is set, and the reciprocal of its most significant word is computed.
+/// \param y Divisor.
+
+uintx_divisor::uintx_divisor(const uintx_t& y): m_cDivisor(y){
+  if(!y.m_bNaN && !y.is_zero()){
+    m_nShift = nlz(y.m_pData[y.m_nSize - 1]);
+    lshiftx(y, m_nShift, m_cNormal);
+    m_nInverse = reciprocal(m_cNormal.m_pData[m_cNormal.m_nSize - 1]);
+  } //if
+} //constructor
+
+/// Get the divisor.
+/// \return The divisor.
+
+const uintx_t& uintx_divisor::divisor() const{
+  return m_cDivisor;
+} //divisor
+
+/// Divide by the divisor. The dividend is shifted into the scratch space,
+/// which only grows if it is too small, and divided in place by
+/// divrem_norm(). The quotient and remainder are written into the results
+/// without allocating if they are large enough. Either result may be the
+/// same object as the dividend, but not as each other.
+/// \param x Dividend.
+/// \param q [out] Pointer to the quotient, or nullptr if not wanted.
+/// \param r [out] Pointer to the remainder, or nullptr if not wanted.
+
+void uintx_divisor::divide(const uintx_t& x, uintx_t* q, uintx_t* r) const{
+  if(x.m_bNaN || m_cDivisor.m_bNaN || m_cDivisor.is_zero()){
+    if(q)*q = uintx_t::NaN;
+    if(r)*r = uintx_t::NaN;
+  } //if
+
+  else if(x < m_cDivisor){ //assign r first in case q is the same object as x
+    if(r)*r = x;
+    if(q)*q = 0;
+  } //else if
+
+  else{
+    const uint32_t n = x.m_nSize; //number of words in the dividend
+    const uint32_t m = m_cNormal.m_nSize; //number of words in the divisor
+
+    m_cScratch.resize(n + 1);
+    word_t* u = m_cScratch.m_pData; //shifted dividend
+    u[n] = lshift(u, x.m_pData, n, m_nShift);
+
+    if(q)q->resize(n - m + 1); //the dividend is no longer needed
+
+    divrem_norm(q? q->m_pData: nullptr, u, n, m_cNormal.m_pData, m,
+      m_nInverse);
+
+    if(q)q->normalize(); //remove leading zero words
+
+    if(r){
+      r->resize(m);
+      rshift(r->m_pData, u, m, m_nShift); //unshift the remainder
+      r->normalize(); //remove leading zero words
+    } //if
+  } //else
+} //divide
+
+/// Divide, rounding down.
+/// \param x Dividend.
+/// \return Floor of the dividend divided by the divisor.
+
+uintx_t uintx_divisor::div(const uintx_t& x) const{
+  uintx_t q; //quotient
+  divide(x, &q, nullptr);
+  return q;
+} //div
+
+/// Remainder after division.
+/// \param x Dividend.
+/// \return Remainder after the dividend is divided by the divisor.
+
+uintx_t uintx_divisor::mod(const uintx_t& x) const{
+  uintx_t r; //remainder
+  divide(x, nullptr, &r);
+  return r;
+} //mod
+
+/// Compute the quotient and the remainder together. The results reuse
+/// their own storage, so that, for example, reducing many numbers into
+/// the same remainder inside a loop does not allocate memory. Either
+/// result may be the same object as the dividend, but the two results
+/// must be different objects.
+/// \param x Dividend.
+/// \param q [out] Floor of the dividend divided by the divisor.
+/// \param r [out] Remainder after the dividend is divided by the divisor.
+
+void uintx_divisor::divmod(const uintx_t& x, uintx_t& q, uintx_t& r) const{
+  divide(x, &q, &r);
+} //divmod
@@ -0,0 +1,47 @@
+/// \file uintx_divisor.h
+/// \brief Declaration of the prepared divisor class.
+
+#if !defined(__uintx_divisor__)
+#define __uintx_divisor__
+
+#include "uintx_t.h"
+
+/// \brief A divisor prepared for repeated division.
+///
+/// Division by an extensible unsigned integer starts by shifting the divisor
+/// left so that its most significant bit is set, and computing a reciprocal
+/// of its most significant word that turns each division of a double word
+/// by it into a couple of multiplications. When the same divisor is used
+/// many times, for example to reduce many numbers modulo it, constructing a
+/// uintx_divisor does this once instead of every time. It also keeps the
+/// scratch space for the shifted dividend from one division to the next, and
+/// divmod() writes into results that keep their own storage, so repeated
+/// division by the same divisor need not allocate any memory. Since the
+/// scratch space is shared, a uintx_divisor must not be used by more than
+/// one thread at a time.
+///
+/// The results are the same as those of the division and remainder
+/// operators, including NaN if the dividend or the divisor is NaN or the
+/// divisor is zero.
+
+class uintx_divisor{
+  private:
+    uintx_t m_cDivisor; ///< The divisor.
+    uintx_t m_cNormal; ///< The divisor shifted so that its most significant bit is set.
+    uint32_t m_nShift = 0; ///< Shift distance in bits.
+    word_t m_nInverse = 0; ///< Reciprocal of the most significant word of m_cNormal.
+    mutable uintx_t m_cScratch; ///< Scratch space for the shifted dividend.
+
+    void divide(const uintx_t&, uintx_t*, uintx_t*) const; ///< Divide.
+
+  public:
+    uintx_divisor(const uintx_t&); ///< Constructor.
+
+    const uintx_t& divisor() const; ///< Get the divisor.
+
+    uintx_t div(const uintx_t&) const; ///< Quotient.
+    uintx_t mod(const uintx_t&) const; ///< Remainder.
+    void divmod(const uintx_t&, uintx_t&, uintx_t&) const; ///< Quotient and remainder.
+}; //uintx_divisor
+
+#endif
@@ -0,0 +1,724 @@
+/// \file uintx_gcd.cpp
+/// \brief Implementation of the greatest common divisor kernels.
+///
+/// Euclid's algorithm with a full division at every step spends most of
+/// its time on quotients that fit into a few bits. Lehmer's algorithm
+/// instead runs Euclid's algorithm on the leading two words of the
+/// operands, using only single- and double-word arithmetic, until the
+/// quotients can no longer be trusted. The quotients found this way are
+/// collected in a 2x2 matrix of single-word cofactors, which is applied to
+/// the full operands in a single pass, taking them almost a word closer to
+/// the gcd. Large operands use the half-GCD algorithm, which finds the
+/// matrix that halves the size of the operands by calling itself
+/// recursively on their leading halves, so that the work is done by
+/// multiplications. Both follow Moller (On Schonhage's Algorithm and
+/// Subquadratic Integer GCD Computation, Mathematics of Computation
+/// 77(261), 2008) in the form used by GMP. Operands that have been reduced
+/// to two words are finished by the binary algorithm, which needs only
+/// shifts and subtractions.
+///
+/// A reduction matrix M has non-negative entries and determinant 1, and
+/// takes the reduced operands back to the ones it started from, that is,
+/// \f$(A, B)^T = M (a, b)^T\f$. The reduced operands therefore have the
+/// same gcd, and are found from the original ones by multiplying them by
+/// the inverse of M, which is why the operands are overwritten.
+
+#include "uintx_gcd.h"
+#include "uintx_div.h"
+#include "uintx_kernel.h"
+#include "uintx_mul.h"
+#include "uintx_tune.h"
+
+#include <algorithm>
+
+const uint32_t BITS_IN_WORD = 8*sizeof(word_t); ///< Number of bits in a word.
+const word_t HIGH_BIT = word_t(1) << (BITS_IN_WORD - 1); ///< Most significant bit of a word.
+const word_t HALF_LIMIT = word_t(1) << (BITS_IN_WORD/2); ///< Smallest word with more than half a word of bits.
+
+uint32_t g_nGCDThreshold = UINTX_GCD_THRESHOLD; ///< Half-GCD threshold.
+
+/////////////////////////////////////////////////////////////////////////////
+// Helper functions.
+
+#pragma region helpers
+
+/// Test whether an n-word gcd should use the half-GCD algorithm, which
+/// needs at least 4 words to split.
+/// \param n Number of words in the larger operand.
+/// \return true if the half-GCD algorithm should be used.
+
+static bool UseHGCD(uint32_t n){
+  return n >= std::max(g_nGCDThreshold, 4U);
+} //UseHGCD
+
+/// Number of significant words in an array.
+/// \param a Array of n words.
+/// \param n Number of words.
+/// \return Number of words up to and including the most significant
+/// non-zero one, or 0 if they are all zero.
+
+static uint32_t normalized(const word_t* a, uint32_t n){
+  while(n > 0 && a[n - 1] == 0)
+    --n;
+
+  return n;
+} //normalized
+
+/// Number of trailing zero bits in a double word.
+/// \param w A non-zero double word.
+/// \return Number of zero bits below the least significant one bit.
+
+static uint32_t ntz2(dword_t w){
+  return word_t(w) != 0? ntz(word_t(w)): BITS_IN_WORD + ntz(word_t(w >> BITS_IN_WORD));
+} //ntz2
+
+/// Binary gcd of two double words. The common power of two is taken out
+/// first, after which the smaller operand is repeatedly subtracted from the
+/// larger and the trailing zeros of the difference shifted away.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return The greatest common divisor of x and y.
+
+static dword_t gcd_2(dword_t x, dword_t y){
+  if(x == 0)return y;
+  if(y == 0)return x;
+
+  const uint32_t k = ntz2(x | y); //power of two in the gcd
+  x >>= ntz2(x);
+
+  while(y != 0){ //x is odd
+    y >>= ntz2(y);
+    if(x > y)std::swap(x, y);
+    y -= x;
+  } //while
+
+  return x << k;
+} //gcd_2
+
+#pragma endregion helpers
+
+/////////////////////////////////////////////////////////////////////////////
+// Reduction matrices.
+
+#pragma region matrices
+
+/// \brief A reduction matrix with multi-word entries.
+///
+/// All four entries have room for the same number of words, and m_nSize is
+/// the number of words in the largest of them. The words above that are
+/// kept zero. The entries of a matrix that reduces a pair of n-word numbers
+/// to more than half their size have fewer than n/2 words, which is what
+/// the space is allocated for.
+
+class matrix{
+  private:
+    word_t* m_pData; ///< Storage for all four entries.
+
+  public:
+    uint32_t m_nSize = 1; ///< Number of words in the largest entry.
+    word_t* m_pEntry[2][2]; ///< Entries, each in an array of words.
+
+    matrix(uint32_t); ///< Constructor.
+    matrix(const matrix&) = delete; ///< Copy constructor.
+    ~matrix(); ///< Destructor.
+}; //matrix
+
+/// Constructor. The matrix is set to the identity.
+/// \param n Number of words in the operands that it will reduce.
+
+matrix::matrix(uint32_t n){
+  const uint32_t size = n/2 + 2; //words in each entry
+  m_pData = new word_t[4*size](); //zeroed
+
+  for(uint32_t i=0; i<4; i++)
+    m_pEntry[i/2][i%2] = m_pData + i*size;
+
+  m_pEntry[0][0][0] = m_pEntry[1][1][0] = 1;
+} //constructor
+
+/// Destructor.
+
+matrix::~matrix(){
+  delete [] m_pData;
+} //destructor
+
+/// Multiply a matrix on the right by a matrix of single words from hgcd2(),
+/// that is, \f$M \leftarrow MU\f$.
+/// \param M [in, out] Matrix.
+/// \param u Matrix of single words.
+/// \param t Scratch space of M.m_nSize words.
+
+static void matrix_mul_1(matrix& M, const word_t u[2][2], word_t* t){
+  const uint32_t n = M.m_nSize; //number of words in the entries
+  word_t carry = 0; //whether the entries have grown
+
+  for(uint32_t i=0; i<2; i++){
+    word_t* a = M.m_pEntry[i][0]; //left entry of row i
+    word_t* b = M.m_pEntry[i][1]; //right entry of row i
+    std::copy(a, a + n, t);
+
+    a[n] = mul_1(a, a, n, u[0][0]);
+    a[n] += addmul_1(a, b, n, u[1][0]);
+    b[n] = mul_1(b, b, n, u[1][1]);
+    b[n] += addmul_1(b, t, n, u[0][1]);
+
+    carry |= a[n] | b[n];
+  } //for
+
+  if(carry != 0)
+    M.m_nSize++;
+} //matrix_mul_1
+
+/// Add q times one column of a matrix to the other, which is the same as
+/// multiplying it on the right by a matrix with a single quotient q off
+/// the diagonal. This records the step \f$b \leftarrow b - qa\f$ for column
+/// 0, or \f$a \leftarrow a - qb\f$ for column 1.
+/// \param M [in, out] Matrix.
+/// \param q Quotient of qn words.
+/// \param qn Number of words in the quotient.
+/// \param col Column to add to.
+/// \param t Scratch space of M.m_nSize + qn words.
+
+static void matrix_update(matrix& M, const word_t* q, uint32_t qn,
+  uint32_t col, word_t* t)
+{
+  const uint32_t n = M.m_nSize; //number of words in the entries
+  uint32_t size = n; //number of words in the updated entries
+  qn = normalized(q, qn);
+
+  for(uint32_t i=0; i<2; i++){
+    word_t* a = M.m_pEntry[i][col]; //entry to add to
+    const word_t* b = M.m_pEntry[i][1 - col]; //entry to multiply by q
+
+    if(qn == 1){
+      a[n] = addmul_1(a, b, n, q[0]);
+      if(a[n] != 0)size = n + 1;
+    } //if
+
+    else{
+      mul(t, b, n, q, qn);
+      const uint32_t tn = normalized(t, n + qn); //words in the product
+
+      if(tn > n){
+        a[tn] = add(a, t, tn, a, n);
+        size = std::max(size, tn + (a[tn] != 0));
+      } //if
+
+      else if(tn > 0){
+        a[n] = add(a, a, n, t, tn);
+        if(a[n] != 0)size = std::max(size, n + 1);
+      } //else if
+    } //else
+  } //for
+
+  M.m_nSize = size;
+} //matrix_update
+
+/// Multiply a matrix on the right by another, that is, \f$M \leftarrow
+/// MN\f$.
+/// \param M [in, out] Matrix.
+/// \param N Matrix.
+
+static void matrix_mul(matrix& M, const matrix& N){
+  const uint32_t n = M.m_nSize; //number of words in the entries of M
+  const uint32_t m = n + N.m_nSize; //number of words in their products
+  word_t* s = new word_t[6*m + 4]; //products and sums
+  word_t* t = s + 4*(m + 1); //product, 2m words
+  uint32_t size = 0; //number of words in the result
+
+  for(uint32_t i=0; i<4; i++){ //entry (i/2, i%2) of the result
+    word_t* r = s + i*(m + 1);
+    mul(r, M.m_pEntry[i/2][0], n, N.m_pEntry[0][i%2], N.m_nSize);
+    mul(t, M.m_pEntry[i/2][1], n, N.m_pEntry[1][i%2], N.m_nSize);
+    r[m] = add_n(r, r, t, m);
+    size = std::max(size, normalized(r, m + 1));
+  } //for
+
+  for(uint32_t i=0; i<4; i++){
+    word_t* r = s + i*(m + 1);
+    word_t* a = M.m_pEntry[i/2][i%2];
+    std::copy(r, r + size, a);
+    if(size < n)std::fill(a + size, a + n, 0);
+  } //for
+
+  M.m_nSize = size;
+  delete [] s;
+} //matrix_mul
+
+#pragma endregion matrices
+
+/////////////////////////////////////////////////////////////////////////////
+// Reduction steps.
+
+#pragma region steps
+
+/// Lehmer's inner loop, following GMP's mpn_hgcd2(). Euclid's algorithm is
+/// run on the leading two words of a pair of numbers for as long as the
+/// remainders keep more than a word of bits, which guarantees that the
+/// quotients are the same as for the full numbers. The quotients are found by
+/// double-word division, by a word division once the leading words have
+/// shrunk to half a word, and by a subtraction when they are 1, which is
+/// the most common case.
+/// \param ah Most significant word of a.
+/// \param al Next word of a.
+/// \param bh Most significant word of b.
+/// \param bl Next word of b.
+/// \param u [out] Reduction matrix of single words, if successful.
+/// \return true if at least one step could be taken.
+
+static bool hgcd2(word_t ah, word_t al, word_t bh, word_t bl, word_t u[2][2]){
+  if(ah < 2 || bh < 2)
+    return false;
+
+  //subtract the smaller from the larger once, so that the loops can tell
+  //whether the next quotient is 1 from a comparison
+
+  const dword_t B = dword_t(1) << BITS_IN_WORD; //radix
+  dword_t a = ah*B + al, b = bh*B + bl; //leading two words
+  bool bTurn; //whether b is the next to be reduced
+
+  if(a > b){
+    a -= b;
+    if(a < 2*B)return false;
+    u[0][0] = u[0][1] = u[1][1] = 1;
+    u[1][0] = 0;
+    bTurn = a < b;
+  } //if
+
+  else{
+    b -= a;
+    if(b < 2*B)return false;
+    u[0][0] = u[1][0] = u[1][1] = 1;
+    u[0][1] = 0;
+    bTurn = a < b;
+  } //else
+
+  //double-word steps, until the larger high word is less than half a word
+
+  for(;;){
+    dword_t& x = bTurn? b: a; //larger, to be reduced
+    const dword_t y = bTurn? a: b; //smaller
+    const uint32_t col = bTurn? 0: 1; //column of u to update
+
+    if(x == y)
+      return true;
+
+    if(word_t(x >> BITS_IN_WORD) < HALF_LIMIT){
+      a >>= BITS_IN_WORD/2;
+      b >>= BITS_IN_WORD/2;
+      break;
+    } //if
+
+    x -= y;
+
+    if(x < 2*B)
+      return true;
+
+    word_t q = 1; //quotient
+
+    if(x > y){
+      q = word_t(x/y);
+      x %= y;
+
+      if(x < 2*B){ //too small, but the quotient is correct
+        u[0][col] += q*u[0][1 - col];
+        u[1][col] += q*u[1][1 - col];
+        return true;
+      } //if
+
+      q++; //count the first subtraction
+    } //if
+
+    u[0][col] += q*u[0][1 - col];
+    u[1][col] += q*u[1][1 - col];
+    bTurn = !bTurn;
+  } //for
+
+  //single-word steps on the leading word and a half, which now fit into a
+  //word, until the remainder is less than half a word and one bit
+
+  const word_t limit = word_t(2)*HALF_LIMIT; //smallest remainder allowed
+
+  word_t x = word_t(bTurn? b: a); //larger, to be reduced
+  word_t y = word_t(bTurn? a: b); //smaller
+
+  for(;;){
+    const uint32_t col = bTurn? 0: 1; //column of u to update
+    x -= y;
+
+    if(x < limit)
+      break;
+
+    word_t q = 1; //quotient
+
+    if(x > y){
+      q = x/y;
+      x %= y;
+
+      if(x < limit){ //too small, but the quotient is correct
+        u[0][col] += q*u[0][1 - col];
+        u[1][col] += q*u[1][1 - col];
+        break;
+      } //if
+
+      q++; //count the first subtraction
+    } //if
+
+    u[0][col] += q*u[0][1 - col];
+    u[1][col] += q*u[1][1 - col];
+    bTurn = !bTurn;
+    std::swap(x, y);
+  } //for
+
+  return true;
+} //hgcd2
+
+/// Apply the inverse of a single-word reduction matrix to a pair of
+/// n-word numbers, that is, \f$r \leftarrow u_{11}a - u_{01}b\f$ and
+/// \f$b \leftarrow u_{00}b - u_{10}a\f$. Both results are known to be
+/// non-negative and no larger than the operands, so the words carried out
+/// of the top cancel.
+/// \param u Reduction matrix from hgcd2().
+/// \param r [out] First result of n words, not overlapping a or b.
+/// \param a First operand of n words.
+/// \param b [in, out] Second operand of n words.
+/// \param n Number of words in the operands.
+/// \return Number of words in the larger result, which is n or n - 1.
+
+static uint32_t mul_1_inverse(const word_t u[2][2], word_t* r,
+  const word_t* a, word_t* b, uint32_t n)
+{
+  mul_1(r, a, n, u[1][1]);
+  submul_1(r, b, n, u[0][1]);
+
+  mul_1(b, b, n, u[0][0]);
+  submul_1(b, a, n, u[1][0]);
+
+  return (r[n - 1] | b[n - 1]) == 0? n - 1: n;
+} //mul_1_inverse
+
+/// Apply the inverse of a reduction matrix found from the leading words of
+/// a pair of numbers to the whole numbers. If the leading words were
+/// reduced to alpha and beta by M, and the low p words of the operands are
+/// \f$a_0\f$ and \f$b_0\f$, then the results are \f$\alpha B^p + m_{11}a_0
+/// - m_{01}b_0\f$ and \f$\beta B^p + m_{00}b_0 - m_{10}a_0\f$, where B is
+/// the radix.
+/// \param M Reduction matrix, with fewer words than the reduced leading
+/// words.
+/// \param n Number of words in the operands, p plus the number of words in
+/// the reduced leading words.
+/// \param a [in, out] First operand, with room for n + 1 words.
+/// \param b [in, out] Second operand, with room for n + 1 words.
+/// \param p Number of low words not seen by M.
+/// \param t Scratch space of 2(p + M.m_nSize) words.
+/// \return Number of words in the larger result.
+
+static uint32_t matrix_adjust(const matrix& M, uint32_t n, word_t* a,
+  word_t* b, uint32_t p, word_t* t)
+{
+  const uint32_t m = M.m_nSize; //number of words in the entries
+  word_t* t0 = t; //product, p + m words
+  word_t* t1 = t + p + m; //product, p + m words
+
+  //compute both products with a first, since it is overwritten
+
+  mul(t0, a, p, M.m_pEntry[1][1], m);
+  mul(t1, a, p, M.m_pEntry[1][0], m);
+
+  std::copy(t0, t0 + p, a);
+  word_t ah = add(a + p, a + p, n - p, t0 + p, m); //word carried out of a
+
+  mul(t0, b, p, M.m_pEntry[0][1], m);
+  ah -= sub(a, a, n, t0, p + m);
+
+  mul(t0, b, p, M.m_pEntry[0][0], m);
+  std::copy(t0, t0 + p, b);
+  word_t bh = add(b + p, b + p, n - p, t0 + p, m); //word carried out of b
+  bh -= sub(b, b, n, t1, p + m);
+
+  if(ah > 0 || bh > 0){
+    a[n] = ah;
+    b[n] = bh;
+    return n + 1;
+  } //if
+
+  return (a[n - 1] | b[n - 1]) == 0? n - 1: n;
+} //matrix_adjust
+
+/// Reduce the larger of a pair of numbers by the smaller one with a
+/// division, unless that would leave the remainder with at most s words.
+/// In that case a quotient one smaller is used instead, if it is not zero.
+/// \param a [in, out] First operand of n words.
+/// \param b [in, out] Second operand of n words.
+/// \param n Number of words in the operands.
+/// \param s Smallest number of words that a reduced operand must have.
+/// \param M [in, out] Reduction matrix, which is updated with the quotient.
+/// \param t Scratch space of 3n words.
+/// \return Number of words in the larger result, or 0 if the operands
+/// could not be reduced, in which case they are unchanged.
+
+static uint32_t subdiv_step(word_t* a, word_t* b, uint32_t n, uint32_t s,
+  matrix& M, word_t* t)
+{
+  word_t* x = a; //smaller operand
+  word_t* y = b; //larger operand
+  uint32_t xn = normalized(a, n); //number of words in x
+  uint32_t yn = normalized(b, n); //number of words in y
+  uint32_t col = 0; //column of M to update
+
+  if(xn > yn || (xn == yn && cmp(a, b, xn) >= 0)){
+    if(xn == yn && cmp(a, b, xn) == 0)
+      return 0;
+
+    std::swap(x, y);
+    std::swap(xn, yn);
+    col = 1;
+  } //if
+
+  if(xn <= s)
+    return 0;
+
+  const uint32_t qn = yn - xn + 1; //number of words in the quotient
+  word_t* q = t; //quotient
+  word_t* r = q + qn; //remainder, xn + 1 words
+  const word_t one = 1; //for decrementing the quotient
+
+  divrem(q, r, y, yn, x, xn);
+  r[xn] = 0;
+
+  if(normalized(r, xn) <= s){ //remainder too small, use one less
+    sub(q, q, qn, &one, 1);
+
+    if(normalized(q, qn) == 0)
+      return 0;
+
+    r[xn] = add_n(r, r, x, xn);
+  } //if
+
+  const uint32_t rn = normalized(r, xn + 1); //number of words in the remainder
+  std::copy(r, r + rn, y);
+  std::fill(y + rn, y + yn, 0);
+
+  matrix_update(M, q, qn, col, r + xn + 1);
+
+  return std::max(normalized(a, n), normalized(b, n));
+} //subdiv_step
+
+/// A single reduction step of the half-GCD algorithm, which is a Lehmer
+/// step on the leading words if possible, or a division step otherwise.
+/// \param n Number of words in the operands.
+/// \param a [in, out] First operand of n words.
+/// \param b [in, out] Second operand of n words.
+/// \param s Smallest number of words that a reduced operand must have.
+/// \param M [in, out] Reduction matrix, which is updated with the step.
+/// \param t Scratch space of 3n words.
+/// \return Number of words in the larger result, or 0 if the operands
+/// could not be reduced, in which case they are unchanged.
+
+static uint32_t hgcd_step(uint32_t n, word_t* a, word_t* b, uint32_t s,
+  matrix& M, word_t* t)
+{
+  const word_t mask = a[n - 1] | b[n - 1]; //for the leading bit
+  word_t ah, al, bh, bl; //leading two words
+
+  if(n == s + 1){ //no more than a few bits may be taken off
+    if(mask < 4)
+      return subdiv_step(a, b, n, s, M, t);
+
+    ah = a[n - 1]; al = a[n - 2];
+    bh = b[n - 1]; bl = b[n - 2];
+  } //if
+
+  else if(mask & HIGH_BIT){
+    ah = a[n - 1]; al = a[n - 2];
+    bh = b[n - 1]; bl = b[n - 2];
+  } //else if
+
+  else{ //shift the leading bit to the top
+    const uint32_t d = nlz(mask); //shift distance
+    ah = (a[n - 1] << d) | (a[n - 2] >> (BITS_IN_WORD - d));
+    al = (a[n - 2] << d) | (a[n - 3] >> (BITS_IN_WORD - d));
+    bh = (b[n - 1] << d) | (b[n - 2] >> (BITS_IN_WORD - d));
+    bl = (b[n - 2] << d) | (b[n - 3] >> (BITS_IN_WORD - d));
+  } //else
+
+  word_t u[2][2]; //reduction matrix from the leading words
+
+  if(hgcd2(ah, al, bh, bl, u)){
+    matrix_mul_1(M, u, t);
+    std::copy(a, a + n, t);
+    return mul_1_inverse(u, a, t, b, n);
+  } //if
+
+  return subdiv_step(a, b, n, s, M, t);
+} //hgcd_step
+
+#pragma endregion steps
+
+/////////////////////////////////////////////////////////////////////////////
+// Half-GCD.
+
+#pragma region hgcd
+
+/// The half-GCD algorithm. A pair of n-word numbers is reduced as far as
+/// possible while both keep more than n/2 + 1 words, and the matrix that
+/// does it is found. The leading half of the operands is reduced first by
+/// calling this recursively, and the result applied to the rest of the
+/// operands with matrix_adjust(). The second recursive call on what is left
+/// of the leading words reduces them to about half their size. Any
+/// remaining words are taken off by Lehmer steps, which are also all that
+/// is done for operands below the threshold.
+/// \param a [in, out] First operand of n words.
+/// \param b [in, out] Second operand of n words.
+/// \param n Number of words in the operands, at least one of whose most
+/// significant words is non-zero.
+/// \param M [in, out] Identity matrix, replaced by the reduction matrix.
+/// \param t Scratch space of 3n words.
+/// \return Number of words in the larger result, or 0 if the operands
+/// could not be reduced, in which case they are unchanged.
+
+static uint32_t hgcd(word_t* a, word_t* b, uint32_t n, matrix& M, word_t* t){
+  const uint32_t s = n/2 + 1; //smallest size of the results
+  bool bSuccess = false; //whether any reduction has been done
+
+  if(n <= s)
+    return 0;
+
+  if(UseHGCD(n)){
+    const uint32_t n2 = 3*n/4 + 1; //size at which to recurse again
+    uint32_t p = n/2; //number of low words to leave out
+    uint32_t nn = hgcd(a + p, b + p, n - p, M, t); //words in reduced leading words
+
+    if(nn > 0){
+      n = matrix_adjust(M, p + nn, a, b, p, t);
+      bSuccess = true;
+    } //if
+
+    while(n > n2){ //reduce the rest of the first half
+      nn = hgcd_step(n, a, b, s, M, t);
+      if(nn == 0)return bSuccess? n: 0;
+      n = nn;
+      bSuccess = true;
+    } //while
+
+    if(n > s + 2){ //second half
+      p = 2*s - n + 1;
+      matrix N(n - p); //reduction matrix of the second half
+      nn = hgcd(a + p, b + p, n - p, N, t);
+
+      if(nn > 0){
+        n = matrix_adjust(N, p + nn, a, b, p, t);
+        matrix_mul(M, N);
+        bSuccess = true;
+      } //if
+    } //if
+  } //if
+
+  for(;;){ //Lehmer steps
+    const uint32_t nn = hgcd_step(n, a, b, s, M, t); //number of words left
+    if(nn == 0)return bSuccess? n: 0;
+    n = nn;
+    bSuccess = true;
+  } //for
+} //hgcd
+
+#pragma endregion hgcd
+
+/// Greatest common divisor of two n-word numbers. Operands that are large
+/// enough are reduced by the half-GCD algorithm, which takes off about a
+/// third of their words at a time, and others by Lehmer steps. When those
+/// cannot make progress, which is rare, the larger operand is reduced
+/// modulo the smaller one instead. Both operands are overwritten.
+/// \param r [out] Greatest common divisor of at most n words.
+/// \param a [in, out] First operand of n words.
+/// \param b [in, out] Second operand of n words.
+/// \param n Number of words in the operands, at least 1.
+/// \return Number of words in the gcd, which is 0 if both operands are
+/// zero.
+
+uint32_t gcd(word_t* r, word_t* a, word_t* b, uint32_t n){
+  word_t* t = new word_t[3*n + 8]; //scratch space
+
+  for(;;){
+    const uint32_t an = normalized(a, n); //number of words in a
+    const uint32_t bn = normalized(b, n); //number of words in b
+
+    if(an == 0 || bn == 0){ //the other one is the gcd
+      const word_t* x = an == 0? b: a;
+      n = std::max(an, bn);
+      std::copy(x, x + n, r);
+      break;
+    } //if
+
+    n = std::max(an, bn);
+
+    if(n <= 2){ //finish with the binary algorithm
+      const dword_t x = n == 2? (dword_t(a[1]) << BITS_IN_WORD) | a[0]: a[0];
+      const dword_t y = n == 2? (dword_t(b[1]) << BITS_IN_WORD) | b[0]: b[0];
+      const dword_t g = gcd_2(x, y); //gcd
+      r[0] = word_t(g);
+      n = 1;
+
+      if((g >> BITS_IN_WORD) != 0) //only if both operands have two words
+        r[n++] = word_t(g >> BITS_IN_WORD);
+
+      break;
+    } //if
+
+    if(UseHGCD(n)){ //reduce by a third with the half-GCD algorithm
+      const uint32_t p = 2*n/3; //number of low words to leave out
+      matrix M(n - p); //reduction matrix
+      const uint32_t nn = hgcd(a + p, b + p, n - p, M, t); //words left
+
+      if(nn > 0){
+        n = matrix_adjust(M, p + nn, a, b, p, t);
+        continue;
+      } //if
+    } //if
+
+    else{ //reduce by almost a word with a Lehmer step
+      const word_t mask = a[n - 1] | b[n - 1]; //for the leading bit
+      const uint32_t d = nlz(mask); //shift distance
+      word_t ah = a[n - 1], al = a[n - 2], bh = b[n - 1], bl = b[n - 2];
+
+      if(d > 0){ //shift the leading bit to the top
+        ah = (ah << d) | (al >> (BITS_IN_WORD - d));
+        al = (al << d) | (a[n - 3] >> (BITS_IN_WORD - d));
+        bh = (bh << d) | (bl >> (BITS_IN_WORD - d));
+        bl = (bl << d) | (b[n - 3] >> (BITS_IN_WORD - d));
+      } //if
+
+      word_t u[2][2]; //reduction matrix
+
+      if(hgcd2(ah, al, bh, bl, u)){
+        std::copy(a, a + n, t);
+        n = mul_1_inverse(u, a, t, b, n);
+        continue;
+      } //if
+    } //else
+
+    //reduce the larger operand modulo the smaller one
+
+    word_t* x = a; //smaller operand
+    word_t* y = b; //larger operand
+    uint32_t xn = an, yn = bn; //number of words in x and y
+
+    if(xn > yn || (xn == yn && cmp(a, b, xn) >= 0)){
+      std::swap(x, y);
+      std::swap(xn, yn);
+    } //if
+
+    if(xn == yn && cmp(x, y, xn) == 0){ //equal operands are the gcd
+      std::copy(x, x + xn, r);
+      n = xn;
+      break;
+    } //if
+
+    divrem(t, t + yn - xn + 1, y, yn, x, xn);
+    std::copy(t + yn - xn + 1, t + yn + 1, y);
+    std::fill(y + xn, y + yn, 0);
+  } //for
+
+  delete [] t;
+  return n;
+} //gcd
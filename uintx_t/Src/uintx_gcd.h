@@ -0,0 +1,16 @@
+/// \file uintx_gcd.h
+/// \brief Declaration of the greatest common divisor kernels.
+///
+/// These functions operate directly on arrays of words stored
+/// least-significant first. They are used to implement gcdx() and are not
+/// part of the public interface. They are built on the word-array kernels
+/// in uintx_kernel.h and the multiplication and division kernels.
+
+#if !defined(__uintx_gcd__)
+#define __uintx_gcd__
+
+#include "uintx_word.h"
+
+uint32_t gcd(word_t*, word_t*, word_t*, uint32_t); ///< Greatest common divisor.
+
+#endif
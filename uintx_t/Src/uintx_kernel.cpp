@@ -0,0 +1,1034 @@
+/// \file uintx_kernel.cpp
+/// \brief Implementation of the word-array kernels.
+///
+/// Each kernel takes a single pass over its operands. The carries, borrows,
+/// and partial products are accumulated in a double word, except that on
+/// x64 the addition and subtraction carry chains use the add-with-carry
+/// intrinsics instead.
+///
+/// On x64 the multiply-accumulate, shift, and bitwise kernels also come in
+/// variants for newer instruction sets: BMI2 and ADX for addmul_1(), and
+/// AVX2 and AVX-512 for the others. The best variant that the processor
+/// supports is chosen once at startup using cpuid, unless the environment
+/// variable `UINTX_KERNELS` names another one, and the public kernels call
+/// it through a function pointer. The portable scalar versions are always
+/// available. The addition and subtraction kernels are not dispatched
+/// because a carry chain cannot be split across vector lanes, and a single
+/// chain gains nothing from ADX.
+
+#include "uintx_kernel.h"
+#include "uintx_tune.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+#if defined(_M_X64)
+  #include <intrin.h>
+  #define UINTX_ADDCARRY64 ///< Use the 64-bit add-with-carry intrinsics.
+  #define UINTX_DISPATCH ///< Select kernel variants at run time.
+  #define UINTX_TARGET(s) ///< Instruction set for a function.
+#elif defined(__x86_64__)
+  #include <x86intrin.h>
+  #include <cpuid.h>
+  #define UINTX_ADDCARRY64 ///< Use the 64-bit add-with-carry intrinsics.
+  #define UINTX_DISPATCH ///< Select kernel variants at run time.
+  #define UINTX_TARGET(s) __attribute__((target(s))) ///< Instruction set for a function.
+#endif
+
+const uint32_t BITS_IN_WORD = 8*sizeof(word_t); ///< Number of bits in a word.
+const uint32_t WORDS_IN_UINT64 = sizeof(uint64_t)/sizeof(word_t); ///< Number of words in 64 bits.
+
+/////////////////////////////////////////////////////////////////////////////
+// Addition and subtraction.
+
+#pragma region addsub
+
+/// Add two n-word numbers. The result may overlap either operand. On x64
+/// the words are added 128 bits at a time as two 64-bit halves using the
+/// add-with-carry intrinsic, which keeps the carry chain to about one
+/// instruction per half. Elsewhere the carry is accumulated in a double
+/// word.
+/// \param r [out] Sum of n words.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+/// \return The carry out of the most significant word.
+
+word_t add_n(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  uint32_t i = 0; //looping variable
+
+  #if defined(UINTX_ADDCARRY64)
+    unsigned char c = 0; //carry into next word
+
+    for(; i+2*WORDS_IN_UINT64<=n; i+=2*WORDS_IN_UINT64){ //128 bits at a time
+      const uint32_t k = WORDS_IN_UINT64; //offset of the high half
+      unsigned long long a0, a1, b0, b1, r0, r1; //64-bit halves
+      memcpy(&a0, a + i, 8); memcpy(&a1, a + i + k, 8);
+      memcpy(&b0, b + i, 8); memcpy(&b1, b + i + k, 8);
+      c = _addcarry_u64(c, a0, b0, &r0);
+      c = _addcarry_u64(c, a1, b1, &r1);
+      memcpy(r + i, &r0, 8); memcpy(r + i + k, &r1, 8);
+    } //for
+
+    dword_t carry = c; //carry into next word
+  #else
+    dword_t carry = 0; //carry into next word
+  #endif
+
+  for(; i<n; i++){
+    const dword_t t = (dword_t)a[i] + b[i] + carry;
+    r[i] = word_t(t);
+    carry = t >> BITS_IN_WORD;
+  } //for
+
+  return word_t(carry);
+} //add_n
+
+/// Subtract an n-word number from another. The result may overlap
+/// either operand. This is done the same way as add_n().
+/// \param r [out] Difference of n words.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+/// \return The borrow out of the most significant word.
+
+word_t sub_n(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  uint32_t i = 0; //looping variable
+
+  #if defined(UINTX_ADDCARRY64)
+    unsigned char c = 0; //borrow from next word
+
+    for(; i+2*WORDS_IN_UINT64<=n; i+=2*WORDS_IN_UINT64){ //128 bits at a time
+      const uint32_t k = WORDS_IN_UINT64; //offset of the high half
+      unsigned long long a0, a1, b0, b1, r0, r1; //64-bit halves
+      memcpy(&a0, a + i, 8); memcpy(&a1, a + i + k, 8);
+      memcpy(&b0, b + i, 8); memcpy(&b1, b + i + k, 8);
+      c = _subborrow_u64(c, a0, b0, &r0);
+      c = _subborrow_u64(c, a1, b1, &r1);
+      memcpy(r + i, &r0, 8); memcpy(r + i + k, &r1, 8);
+    } //for
+
+    word_t borrow = c; //borrow from next word
+  #else
+    word_t borrow = 0; //borrow from next word
+  #endif
+
+  for(; i<n; i++){
+    const dword_t t = (dword_t)a[i] - b[i] - borrow;
+    r[i] = word_t(t);
+    borrow = word_t(t >> BITS_IN_WORD) & 1;
+  } //for
+
+  return borrow;
+} //sub_n
+
+/// Add an m-word number to an n-word number, where \f$m \leq n\f$.
+/// Once the carry dies out the rest of the longer operand is copied, which
+/// is skipped when the result is the same as that operand.
+/// \param r [out] Sum of n words, which may overlap either operand.
+/// \param a First operand of n words.
+/// \param n Number of words in the first operand.
+/// \param b Second operand of m words.
+/// \param m Number of words in the second operand.
+/// \return The carry out of the most significant word.
+
+word_t add(word_t* r, const word_t* a, uint32_t n,
+  const word_t* b, uint32_t m)
+{
+  word_t carry = add_n(r, a, b, m);
+  uint32_t i = m; //looping variable
+
+  for(; i<n && carry; i++){
+    r[i] = a[i] + 1;
+    carry = r[i] == 0;
+  } //for
+
+  if(r != a)
+    std::copy(a + i, a + n, r + i);
+
+  return carry;
+} //add
+
+/// Subtract an m-word number from an n-word number, where
+/// \f$m \leq n\f$. This is done the same way as add().
+/// \param r [out] Difference of n words, which may overlap either operand.
+/// \param a First operand of n words.
+/// \param n Number of words in the first operand.
+/// \param b Second operand of m words.
+/// \param m Number of words in the second operand.
+/// \return The borrow out of the most significant word.
+
+word_t sub(word_t* r, const word_t* a, uint32_t n,
+  const word_t* b, uint32_t m)
+{
+  word_t borrow = sub_n(r, a, b, m);
+  uint32_t i = m; //looping variable
+
+  for(; i<n && borrow; i++){
+    const word_t w = a[i]; //r and a may be the same
+    r[i] = w - 1;
+    borrow = w == 0;
+  } //for
+
+  if(r != a)
+    std::copy(a + i, a + n, r + i);
+
+  return borrow;
+} //sub
+
+#pragma endregion addsub
+
+/////////////////////////////////////////////////////////////////////////////
+// Multiplication by a word.
+
+#pragma region mul1
+
+/// Multiply a multi-word number by a single word, that is,
+/// \f$r \leftarrow a \times w\f$. The result may be the same as the
+/// multiplicand.
+/// \param r [out] Product of n words.
+/// \param a Multiplicand of n words.
+/// \param n Number of words in the multiplicand.
+/// \param w Single-word multiplier.
+/// \return The word carried out of the most significant end.
+
+word_t mul_1(word_t* r, const word_t* a, uint32_t n, word_t w){
+  dword_t carry = 0; //carry into next word
+
+  for(uint32_t i=0; i<n; i++){
+    const dword_t t = (dword_t)a[i]*w + carry; //cannot overflow
+    r[i] = word_t(t);
+    carry = t >> BITS_IN_WORD;
+  } //for
+
+  return word_t(carry);
+} //mul_1
+
+/// Multiply a multi-word number by a single word and add the product into
+/// an accumulator, that is, \f$r \leftarrow r + a \times w\f$. Each partial
+/// product is computed in a double word, which is large enough to hold the
+/// product of two words plus a word from the accumulator plus the carry.
+/// \param r [in, out] Accumulator of at least n words.
+/// \param a Multiplicand of n words.
+/// \param n Number of words in the multiplicand.
+/// \param w Single-word multiplier.
+/// \return The word carried out of the most significant end.
+
+static word_t addmul_1_scalar(word_t* r, const word_t* a, uint32_t n, word_t w){
+  dword_t carry = 0; //carry into next word
+
+  for(uint32_t i=0; i<n; i++){
+    const dword_t t = (dword_t)a[i]*w + r[i] + carry; //cannot overflow
+    r[i] = word_t(t);
+    carry = t >> BITS_IN_WORD;
+  } //for
+
+  return word_t(carry);
+} //addmul_1_scalar
+
+/// Multiply a multi-word number by a single word and subtract the product
+/// from an accumulator, that is, \f$r \leftarrow r - a \times w\f$.
+/// \param r [in, out] Accumulator of at least n words.
+/// \param a Multiplicand of n words.
+/// \param n Number of words in the multiplicand.
+/// \param w Single-word multiplier.
+/// \return The word borrowed from beyond the most significant end.
+
+word_t submul_1(word_t* r, const word_t* a, uint32_t n, word_t w){
+  dword_t borrow = 0; //borrow from next word
+
+  for(uint32_t i=0; i<n; i++){
+    const dword_t t = (dword_t)a[i]*w + borrow; //cannot overflow
+    const word_t lo = word_t(t);
+    borrow = (t >> BITS_IN_WORD) + (r[i] < lo);
+    r[i] -= lo;
+  } //for
+
+  return word_t(borrow);
+} //submul_1
+
+#pragma endregion mul1
+
+/////////////////////////////////////////////////////////////////////////////
+// Shifts.
+
+#pragma region shift
+
+/// Left-shift an n-word number by less than a word. The words are
+/// processed from the most significant end, so the result may be the same
+/// as the operand or start above it, as it does when shifting by whole
+/// words as well.
+/// \param r [out] Result of n words.
+/// \param a Operand of n words, at least 1.
+/// \param n Number of words.
+/// \param d Shift distance in bits, \f$0 \leq d <\f$ BITS_IN_WORD.
+/// \return The bits shifted out of the most significant word, in the least
+/// significant bits of the return value.
+
+static word_t lshift_scalar(word_t* r, const word_t* a, uint32_t n, uint32_t d){
+  if(d == 0){
+    std::copy_backward(a, a + n, r + n);
+    return 0;
+  } //if
+
+  const word_t out = a[n - 1] >> (BITS_IN_WORD - d); //bits shifted out
+
+  for(uint32_t i=n-1; i>0; i--)
+    r[i] = (a[i] << d) | (a[i - 1] >> (BITS_IN_WORD - d));
+
+  r[0] = a[0] << d;
+
+  return out;
+} //lshift_scalar
+
+/// Right-shift an n-word number by less than a word. The words are
+/// processed from the least significant end, so the result may be the same
+/// as the operand or start below it, as it does when shifting by whole
+/// words as well.
+/// \param r [out] Result of n words.
+/// \param a Operand of n words, at least 1.
+/// \param n Number of words.
+/// \param d Shift distance in bits, \f$0 \leq d <\f$ BITS_IN_WORD.
+/// \return The bits shifted out of the least significant word, in the most
+/// significant bits of the return value.
+
+static word_t rshift_scalar(word_t* r, const word_t* a, uint32_t n, uint32_t d){
+  if(d == 0){
+    std::copy(a, a + n, r);
+    return 0;
+  } //if
+
+  const word_t out = a[0] << (BITS_IN_WORD - d); //bits shifted out
+
+  for(uint32_t i=0; i+1<n; i++)
+    r[i] = (a[i] >> d) | (a[i + 1] << (BITS_IN_WORD - d));
+
+  r[n - 1] = a[n - 1] >> d;
+
+  return out;
+} //rshift_scalar
+
+#pragma endregion shift
+
+/////////////////////////////////////////////////////////////////////////////
+// Bitwise operations.
+
+#pragma region bitwise
+
+/// Bitwise AND of two n-word numbers.
+/// \param r [out] Result of n words, which may be the same as either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+
+static void and_n_scalar(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  for(uint32_t i=0; i<n; i++)
+    r[i] = a[i] & b[i];
+} //and_n_scalar
+
+/// Bitwise inclusive OR of two n-word numbers.
+/// \param r [out] Result of n words, which may be the same as either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+
+static void ior_n_scalar(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  for(uint32_t i=0; i<n; i++)
+    r[i] = a[i] | b[i];
+} //ior_n_scalar
+
+/// Bitwise exclusive OR of two n-word numbers.
+/// \param r [out] Result of n words, which may be the same as either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+
+static void xor_n_scalar(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  for(uint32_t i=0; i<n; i++)
+    r[i] = a[i] ^ b[i];
+} //xor_n_scalar
+
+/// Bitwise complement of an n-word number.
+/// \param r [out] Result of n words, which may be the same as the operand.
+/// \param a Operand of n words.
+/// \param n Number of words.
+
+static void com_scalar(word_t* r, const word_t* a, uint32_t n){
+  for(uint32_t i=0; i<n; i++)
+    r[i] = ~a[i];
+} //com_scalar
+
+#pragma endregion bitwise
+
+/////////////////////////////////////////////////////////////////////////////
+// Comparison and division by a word.
+
+#pragma region cmpdiv
+
+/// Compare two n-word numbers from the most significant end.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+/// \return Negative, zero, or positive as a is less than, equal to, or
+/// greater than b.
+
+int cmp(const word_t* a, const word_t* b, uint32_t n){
+  while(n-- > 0)
+    if(a[n] != b[n])
+      return a[n] > b[n]? 1: -1;
+
+  return 0;
+} //cmp
+
+/// Divide an n-word number by a single word. The quotient may be the same
+/// as the dividend.
+/// \param q [out] Quotient of n words, or nullptr if not wanted.
+/// \param a Dividend of n words.
+/// \param n Number of words in the dividend.
+/// \param d Non-zero single-word divisor.
+/// \return The remainder.
+
+word_t divrem_1(word_t* q, const word_t* a, uint32_t n, word_t d){
+  word_t rem = 0; //remainder so far
+
+  for(uint32_t i=n; i-->0;){
+    const word_t w = divw(rem, a[i], d, rem);
+    if(q)q[i] = w;
+  } //for
+
+  return rem;
+} //divrem_1
+
+#pragma endregion cmpdiv
+
+#if defined(UINTX_DISPATCH)
+
+/////////////////////////////////////////////////////////////////////////////
+// Instruction set variants.
+
+#pragma region variants
+
+/// Multiply a multi-word number by a single word and add the product into
+/// an accumulator using the BMI2 and ADX instructions. The words are
+/// processed 64 bits at a time as in add_n(). Since mulx does not change
+/// the flags, the low half of each product can be added to the high half of
+/// the previous product and to the accumulator in two independent carry
+/// chains, adcx using the carry flag and adox using the overflow flag. The
+/// compiler does not keep the chains apart if they are written with
+/// intrinsics, so with g++ the loop is written in assembly language instead,
+/// two 64-bit halves at a time, and counted down with jrcxz, which does
+/// not change the flags either. With 32-bit words the multiplier fits into
+/// 32 bits and the product of 64 bits by 32 bits cannot overflow 128 bits,
+/// so this also halves the number of multiplications.
+/// \param r [in, out] Accumulator of at least n words.
+/// \param a Multiplicand of n words.
+/// \param n Number of words in the multiplicand.
+/// \param w Single-word multiplier.
+/// \return The word carried out of the most significant end.
+
+UINTX_TARGET("bmi2,adx")
+static word_t addmul_1_adx(word_t* r, const word_t* a, uint32_t n, word_t w){
+  const uint32_t k = WORDS_IN_UINT64; //number of words in 64 bits
+  unsigned long long pairs = n/(2*k); //number of pairs of 64-bit halves
+  unsigned long long hi = 0; //high half of the last product
+  uint32_t i = 2*k*uint32_t(pairs); //words done by the main loop
+
+  #if defined(__GNUC__)
+    if(pairs > 0){
+      word_t* p = r; //accumulator
+      const word_t* q = a; //multiplicand
+
+      __asm__ volatile(
+        "xor %%eax, %%eax\n\t" //clear both carries
+        "1:\n\t"
+        "mulx (%[q]), %%rax, %%r9\n\t"
+        "adcx %[hi], %%rax\n\t"
+        "adox (%[p]), %%rax\n\t"
+        "mov %%rax, (%[p])\n\t"
+        "mulx 8(%[q]), %%rax, %[hi]\n\t"
+        "adcx %%r9, %%rax\n\t"
+        "adox 8(%[p]), %%rax\n\t"
+        "mov %%rax, 8(%[p])\n\t"
+        "lea 16(%[q]), %[q]\n\t"
+        "lea 16(%[p]), %[p]\n\t"
+        "lea -1(%%rcx), %%rcx\n\t"
+        "jrcxz 2f\n\t"
+        "jmp 1b\n\t"
+        "2:\n\t"
+        "mov $0, %%eax\n\t" //add both carries into the high half
+        "adcx %%rax, %[hi]\n\t"
+        "adox %%rax, %[hi]\n\t"
+        : [p]"+r"(p), [q]"+r"(q), "+c"(pairs), [hi]"+r"(hi)
+        : "d"((unsigned long long)w)
+        : "rax", "r9", "cc", "memory");
+    } //if
+  #else
+    unsigned char c0 = 0, c1 = 0; //carries of the two chains
+
+    for(uint32_t j=0; j<i; j+=k){
+      unsigned long long x, y, lo, h; //multiplicand, accumulator, and product
+      memcpy(&x, a + j, 8); memcpy(&y, r + j, 8);
+      lo = _mulx_u64(x, w, &h);
+      c0 = _addcarryx_u64(c0, lo, hi, &lo);
+      c1 = _addcarryx_u64(c1, lo, y, &lo);
+      memcpy(r + j, &lo, 8);
+      hi = h;
+    } //for
+
+    hi += c0 + c1; //cannot overflow
+  #endif
+
+  dword_t carry = hi; //carry into next word
+
+  for(; i<n; i++){ //the last few words
+    const dword_t t = (dword_t)a[i]*w + r[i] + carry; //cannot overflow
+    r[i] = word_t(t);
+    carry = t >> BITS_IN_WORD;
+  } //for
+
+  return word_t(carry);
+} //addmul_1_adx
+
+/// Left-shift every word of an AVX2 vector.
+/// \param x Vector of words.
+/// \param d Shift distance in bits.
+/// \return The shifted vector.
+
+UINTX_TARGET("avx2")
+static inline __m256i sll_avx2(__m256i x, __m128i d){
+  return sizeof(word_t) == 4? _mm256_sll_epi32(x, d): _mm256_sll_epi64(x, d);
+} //sll_avx2
+
+/// Right-shift every word of an AVX2 vector.
+/// \param x Vector of words.
+/// \param d Shift distance in bits.
+/// \return The shifted vector.
+
+UINTX_TARGET("avx2")
+static inline __m256i srl_avx2(__m256i x, __m128i d){
+  return sizeof(word_t) == 4? _mm256_srl_epi32(x, d): _mm256_srl_epi64(x, d);
+} //srl_avx2
+
+/// Left-shift an n-word number by less than a word using AVX2. Each vector
+/// of the result is made from two overlapping unaligned loads of the
+/// operand, one word apart, working down from the most significant end
+/// as in lshift_scalar(), which finishes off the last few words.
+/// \param r [out] Result of n words, which may start at or above the operand.
+/// \param a Operand of n words, at least 1.
+/// \param n Number of words.
+/// \param d Shift distance in bits, \f$0 \leq d <\f$ BITS_IN_WORD.
+/// \return The bits shifted out of the most significant word.
+
+UINTX_TARGET("avx2")
+static word_t lshift_avx2(word_t* r, const word_t* a, uint32_t n, uint32_t d){
+  const uint32_t v = sizeof(__m256i)/sizeof(word_t); //words in a vector
+
+  if(d == 0 || n <= v)
+    return lshift_scalar(r, a, n, d);
+
+  const word_t out = a[n - 1] >> (BITS_IN_WORD - d); //bits shifted out
+  const __m128i left = _mm_cvtsi32_si128(int(d)); //shift distance
+  const __m128i right = _mm_cvtsi32_si128(int(BITS_IN_WORD - d)); //complement
+  uint32_t i = n; //words below i are still to be shifted
+
+  for(; i>v; i-=v){
+    const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i - v));
+    const __m256i y = _mm256_loadu_si256((const __m256i*)(a + i - v - 1));
+    _mm256_storeu_si256((__m256i*)(r + i - v),
+      _mm256_or_si256(sll_avx2(x, left), srl_avx2(y, right)));
+  } //for
+
+  lshift_scalar(r, a, i, d);
+  return out;
+} //lshift_avx2
+
+/// Right-shift an n-word number by less than a word using AVX2, working up
+/// from the least significant end as in rshift_scalar().
+/// \param r [out] Result of n words, which may start at or below the operand.
+/// \param a Operand of n words, at least 1.
+/// \param n Number of words.
+/// \param d Shift distance in bits, \f$0 \leq d <\f$ BITS_IN_WORD.
+/// \return The bits shifted out of the least significant word.
+
+UINTX_TARGET("avx2")
+static word_t rshift_avx2(word_t* r, const word_t* a, uint32_t n, uint32_t d){
+  const uint32_t v = sizeof(__m256i)/sizeof(word_t); //words in a vector
+
+  if(d == 0 || n <= v)
+    return rshift_scalar(r, a, n, d);
+
+  const word_t out = a[0] << (BITS_IN_WORD - d); //bits shifted out
+  const __m128i right = _mm_cvtsi32_si128(int(d)); //shift distance
+  const __m128i left = _mm_cvtsi32_si128(int(BITS_IN_WORD - d)); //complement
+  uint32_t i = 0; //words from i up are still to be shifted
+
+  for(; i+v<n; i+=v){
+    const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+    const __m256i y = _mm256_loadu_si256((const __m256i*)(a + i + 1));
+    _mm256_storeu_si256((__m256i*)(r + i),
+      _mm256_or_si256(srl_avx2(x, right), sll_avx2(y, left)));
+  } //for
+
+  rshift_scalar(r + i, a + i, n - i, d);
+  return out;
+} //rshift_avx2
+
+/// Bitwise AND of two n-word numbers using AVX2.
+/// \param r [out] Result of n words, which may be the same as either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+
+UINTX_TARGET("avx2")
+static void and_n_avx2(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  const uint32_t v = sizeof(__m256i)/sizeof(word_t); //words in a vector
+  uint32_t i = 0; //looping variable
+
+  for(; i+v<=n; i+=v){
+    const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+    const __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+    _mm256_storeu_si256((__m256i*)(r + i), _mm256_and_si256(x, y));
+  } //for
+
+  and_n_scalar(r + i, a + i, b + i, n - i);
+} //and_n_avx2
+
+/// Bitwise inclusive OR of two n-word numbers using AVX2.
+/// \param r [out] Result of n words, which may be the same as either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+
+UINTX_TARGET("avx2")
+static void ior_n_avx2(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  const uint32_t v = sizeof(__m256i)/sizeof(word_t); //words in a vector
+  uint32_t i = 0; //looping variable
+
+  for(; i+v<=n; i+=v){
+    const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+    const __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+    _mm256_storeu_si256((__m256i*)(r + i), _mm256_or_si256(x, y));
+  } //for
+
+  ior_n_scalar(r + i, a + i, b + i, n - i);
+} //ior_n_avx2
+
+/// Bitwise exclusive OR of two n-word numbers using AVX2.
+/// \param r [out] Result of n words, which may be the same as either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+
+UINTX_TARGET("avx2")
+static void xor_n_avx2(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  const uint32_t v = sizeof(__m256i)/sizeof(word_t); //words in a vector
+  uint32_t i = 0; //looping variable
+
+  for(; i+v<=n; i+=v){
+    const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+    const __m256i y = _mm256_loadu_si256((const __m256i*)(b + i));
+    _mm256_storeu_si256((__m256i*)(r + i), _mm256_xor_si256(x, y));
+  } //for
+
+  xor_n_scalar(r + i, a + i, b + i, n - i);
+} //xor_n_avx2
+
+/// Bitwise complement of an n-word number using AVX2.
+/// \param r [out] Result of n words, which may be the same as the operand.
+/// \param a Operand of n words.
+/// \param n Number of words.
+
+UINTX_TARGET("avx2")
+static void com_avx2(word_t* r, const word_t* a, uint32_t n){
+  const uint32_t v = sizeof(__m256i)/sizeof(word_t); //words in a vector
+  const __m256i ones = _mm256_set1_epi32(-1); //all bits set
+  uint32_t i = 0; //looping variable
+
+  for(; i+v<=n; i+=v){
+    const __m256i x = _mm256_loadu_si256((const __m256i*)(a + i));
+    _mm256_storeu_si256((__m256i*)(r + i), _mm256_xor_si256(x, ones));
+  } //for
+
+  com_scalar(r + i, a + i, n - i);
+} //com_avx2
+
+/// Left-shift every word of an AVX-512 vector.
+/// \param x Vector of words.
+/// \param d Shift distance in bits.
+/// \return The shifted vector.
+
+UINTX_TARGET("avx512f")
+static inline __m512i sll_avx512(__m512i x, __m128i d){
+  return sizeof(word_t) == 4? _mm512_sll_epi32(x, d): _mm512_sll_epi64(x, d);
+} //sll_avx512
+
+/// Right-shift every word of an AVX-512 vector.
+/// \param x Vector of words.
+/// \param d Shift distance in bits.
+/// \return The shifted vector.
+
+UINTX_TARGET("avx512f")
+static inline __m512i srl_avx512(__m512i x, __m128i d){
+  return sizeof(word_t) == 4? _mm512_srl_epi32(x, d): _mm512_srl_epi64(x, d);
+} //srl_avx512
+
+/// Left-shift an n-word number by less than a word using AVX-512. This is
+/// done the same way as lshift_avx2().
+/// \param r [out] Result of n words, which may start at or above the operand.
+/// \param a Operand of n words, at least 1.
+/// \param n Number of words.
+/// \param d Shift distance in bits, \f$0 \leq d <\f$ BITS_IN_WORD.
+/// \return The bits shifted out of the most significant word.
+
+UINTX_TARGET("avx512f")
+static word_t lshift_avx512(word_t* r, const word_t* a, uint32_t n, uint32_t d){
+  const uint32_t v = sizeof(__m512i)/sizeof(word_t); //words in a vector
+
+  if(d == 0 || n <= v)
+    return lshift_scalar(r, a, n, d);
+
+  const word_t out = a[n - 1] >> (BITS_IN_WORD - d); //bits shifted out
+  const __m128i left = _mm_cvtsi32_si128(int(d)); //shift distance
+  const __m128i right = _mm_cvtsi32_si128(int(BITS_IN_WORD - d)); //complement
+  uint32_t i = n; //words below i are still to be shifted
+
+  for(; i>v; i-=v){
+    const __m512i x = _mm512_loadu_si512(a + i - v);
+    const __m512i y = _mm512_loadu_si512(a + i - v - 1);
+    _mm512_storeu_si512(r + i - v,
+      _mm512_or_si512(sll_avx512(x, left), srl_avx512(y, right)));
+  } //for
+
+  lshift_scalar(r, a, i, d);
+  return out;
+} //lshift_avx512
+
+/// Right-shift an n-word number by less than a word using AVX-512. This is
+/// done the same way as rshift_avx2().
+/// \param r [out] Result of n words, which may start at or below the operand.
+/// \param a Operand of n words, at least 1.
+/// \param n Number of words.
+/// \param d Shift distance in bits, \f$0 \leq d <\f$ BITS_IN_WORD.
+/// \return The bits shifted out of the least significant word.
+
+UINTX_TARGET("avx512f")
+static word_t rshift_avx512(word_t* r, const word_t* a, uint32_t n, uint32_t d){
+  const uint32_t v = sizeof(__m512i)/sizeof(word_t); //words in a vector
+
+  if(d == 0 || n <= v)
+    return rshift_scalar(r, a, n, d);
+
+  const word_t out = a[0] << (BITS_IN_WORD - d); //bits shifted out
+  const __m128i right = _mm_cvtsi32_si128(int(d)); //shift distance
+  const __m128i left = _mm_cvtsi32_si128(int(BITS_IN_WORD - d)); //complement
+  uint32_t i = 0; //words from i up are still to be shifted
+
+  for(; i+v<n; i+=v){
+    const __m512i x = _mm512_loadu_si512(a + i);
+    const __m512i y = _mm512_loadu_si512(a + i + 1);
+    _mm512_storeu_si512(r + i,
+      _mm512_or_si512(srl_avx512(x, right), sll_avx512(y, left)));
+  } //for
+
+  rshift_scalar(r + i, a + i, n - i, d);
+  return out;
+} //rshift_avx512
+
+/// Bitwise AND of two n-word numbers using AVX-512.
+/// \param r [out] Result of n words, which may be the same as either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+
+UINTX_TARGET("avx512f")
+static void and_n_avx512(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  const uint32_t v = sizeof(__m512i)/sizeof(word_t); //words in a vector
+  uint32_t i = 0; //looping variable
+
+  for(; i+v<=n; i+=v)
+    _mm512_storeu_si512(r + i,
+      _mm512_and_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i)));
+
+  and_n_scalar(r + i, a + i, b + i, n - i);
+} //and_n_avx512
+
+/// Bitwise inclusive OR of two n-word numbers using AVX-512.
+/// \param r [out] Result of n words, which may be the same as either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+
+UINTX_TARGET("avx512f")
+static void ior_n_avx512(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  const uint32_t v = sizeof(__m512i)/sizeof(word_t); //words in a vector
+  uint32_t i = 0; //looping variable
+
+  for(; i+v<=n; i+=v)
+    _mm512_storeu_si512(r + i,
+      _mm512_or_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i)));
+
+  ior_n_scalar(r + i, a + i, b + i, n - i);
+} //ior_n_avx512
+
+/// Bitwise exclusive OR of two n-word numbers using AVX-512.
+/// \param r [out] Result of n words, which may be the same as either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+
+UINTX_TARGET("avx512f")
+static void xor_n_avx512(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  const uint32_t v = sizeof(__m512i)/sizeof(word_t); //words in a vector
+  uint32_t i = 0; //looping variable
+
+  for(; i+v<=n; i+=v)
+    _mm512_storeu_si512(r + i,
+      _mm512_xor_si512(_mm512_loadu_si512(a + i), _mm512_loadu_si512(b + i)));
+
+  xor_n_scalar(r + i, a + i, b + i, n - i);
+} //xor_n_avx512
+
+/// Bitwise complement of an n-word number using AVX-512.
+/// \param r [out] Result of n words, which may be the same as the operand.
+/// \param a Operand of n words.
+/// \param n Number of words.
+
+UINTX_TARGET("avx512f")
+static void com_avx512(word_t* r, const word_t* a, uint32_t n){
+  const uint32_t v = sizeof(__m512i)/sizeof(word_t); //words in a vector
+  const __m512i ones = _mm512_set1_epi32(-1); //all bits set
+  uint32_t i = 0; //looping variable
+
+  for(; i+v<=n; i+=v)
+    _mm512_storeu_si512(r + i, _mm512_xor_si512(_mm512_loadu_si512(a + i), ones));
+
+  com_scalar(r + i, a + i, n - i);
+} //com_avx512
+
+#pragma endregion variants
+
+#endif
+
+/////////////////////////////////////////////////////////////////////////////
+// Run-time selection of the kernel variants.
+
+#pragma region dispatch
+
+const uint32_t KERNEL_COUNT = 4; ///< Number of kernel variants.
+
+/// Names of the kernel variants, in increasing order of preference.
+const char* const KERNEL_NAMES[KERNEL_COUNT] = {"scalar", "adx", "avx2", "avx512"};
+
+static uint32_t g_nKernels = 0; ///< Kernel variant in use, an index into KERNEL_NAMES.
+
+static word_t (*g_pAddmul1)(word_t*, const word_t*, uint32_t, word_t) = addmul_1_scalar; ///< addmul_1() variant.
+static word_t (*g_pLshift)(word_t*, const word_t*, uint32_t, uint32_t) = lshift_scalar; ///< lshift() variant.
+static word_t (*g_pRshift)(word_t*, const word_t*, uint32_t, uint32_t) = rshift_scalar; ///< rshift() variant.
+static void (*g_pAnd)(word_t*, const word_t*, const word_t*, uint32_t) = and_n_scalar; ///< and_n() variant.
+static void (*g_pIor)(word_t*, const word_t*, const word_t*, uint32_t) = ior_n_scalar; ///< ior_n() variant.
+static void (*g_pXor)(word_t*, const word_t*, const word_t*, uint32_t) = xor_n_scalar; ///< xor_n() variant.
+static void (*g_pCom)(word_t*, const word_t*, uint32_t) = com_scalar; ///< com() variant.
+
+/// Find out which kernel variants the processor and operating system
+/// support. AVX2 and AVX-512 also need the operating system to save the
+/// vector registers, which is checked using xgetbv.
+/// \return A mask with bit i set if the variant KERNEL_NAMES[i] is supported.
+
+static uint32_t supported(){
+  uint32_t mask = 1; //scalar kernels run anywhere
+
+  #if defined(UINTX_DISPATCH)
+    uint32_t r0[4], r1[4], r7[4] = {0, 0, 0, 0}; //eax, ebx, ecx, edx of leaves 0, 1, 7
+
+    #if defined(_M_X64)
+      int x[4]; //registers
+      __cpuidex(x, 0, 0); std::copy(x, x + 4, r0);
+      __cpuidex(x, 1, 0); std::copy(x, x + 4, r1);
+      if(r0[0] >= 7){__cpuidex(x, 7, 0); std::copy(x, x + 4, r7);}
+    #else
+      __cpuid_count(0, 0, r0[0], r0[1], r0[2], r0[3]);
+      __cpuid_count(1, 0, r1[0], r1[1], r1[2], r1[3]);
+      if(r0[0] >= 7)__cpuid_count(7, 0, r7[0], r7[1], r7[2], r7[3]);
+    #endif
+
+    uint64_t xcr0 = 0; //vector registers saved by the operating system
+
+    if(r1[2] & (1 << 27)){ //xgetbv is available
+      #if defined(_M_X64)
+        xcr0 = _xgetbv(0);
+      #else
+        uint32_t lo, hi; //halves of xcr0
+        __asm__("xgetbv": "=a"(lo), "=d"(hi): "c"(0));
+        xcr0 = ((uint64_t)hi << 32) | lo;
+      #endif
+    } //if
+
+    const bool bmi2 = (r7[1] & (1 << 8)) != 0;
+    const bool adx = (r7[1] & (1 << 19)) != 0;
+    const bool avx2 = (r7[1] & (1 << 5)) != 0 && (xcr0 & 0x06) == 0x06;
+    const bool avx512 = (r7[1] & (1 << 16)) != 0 && (xcr0 & 0xE6) == 0xE6;
+
+    if(bmi2 && adx)mask |= 2;
+    if(avx2)mask |= 4;
+    if(avx512)mask |= 8;
+  #endif
+
+  return mask;
+} //supported
+
+/// Point the kernels at a variant. Kernels that have no version for that
+/// variant, or need an instruction set that the processor does not
+/// support, get the best supported version from an earlier variant.
+/// \param kernels Index of the variant into KERNEL_NAMES.
+/// \param mask Mask of supported variants from supported().
+
+static void use_kernels(uint32_t kernels, uint32_t mask){
+  g_nKernels = kernels;
+
+  g_pAddmul1 = addmul_1_scalar;
+  g_pLshift = lshift_scalar; g_pRshift = rshift_scalar;
+  g_pAnd = and_n_scalar; g_pIor = ior_n_scalar; g_pXor = xor_n_scalar;
+  g_pCom = com_scalar;
+
+  #if defined(UINTX_DISPATCH)
+    if(kernels >= 1 && (mask & 2))
+      g_pAddmul1 = addmul_1_adx;
+
+    if(kernels >= 2 && (mask & 4)){
+      g_pLshift = lshift_avx2; g_pRshift = rshift_avx2;
+      g_pAnd = and_n_avx2; g_pIor = ior_n_avx2; g_pXor = xor_n_avx2;
+      g_pCom = com_avx2;
+    } //if
+
+    if(kernels >= 3 && (mask & 8)){
+      g_pLshift = lshift_avx512; g_pRshift = rshift_avx512;
+      g_pAnd = and_n_avx512; g_pIor = ior_n_avx512; g_pXor = xor_n_avx512;
+      g_pCom = com_avx512;
+    } //if
+  #endif
+} //use_kernels
+
+/// Get the name of the kernel variant in use.
+/// \return One of "scalar", "adx", "avx2", or "avx512".
+
+const char* get_kernels(){
+  return KERNEL_NAMES[g_nKernels];
+} //get_kernels
+
+/// Select a kernel variant by name, for example to check that all of the
+/// variants give the same results.
+/// \param name One of "scalar", "adx", "avx2", or "avx512".
+/// \return true if the variant was selected, false if the name is unknown
+/// or the processor does not support it, in which case the variant in use
+/// is unchanged.
+
+bool set_kernels(const char* name){
+  const uint32_t mask = supported(); //supported variants
+
+  for(uint32_t i=0; i<KERNEL_COUNT; i++)
+    if(strcmp(name, KERNEL_NAMES[i]) == 0 && (mask & (1 << i))){
+      use_kernels(i, mask);
+      return true;
+    } //if
+
+  return false;
+} //set_kernels
+
+/// Select the best supported kernel variant, or the one named by the
+/// environment variable `UINTX_KERNELS` if that is set and supported.
+/// \return true.
+
+static bool init_kernels(){
+  const uint32_t mask = supported(); //supported variants
+  uint32_t best = 0; //best supported variant
+
+  for(uint32_t i=0; i<KERNEL_COUNT; i++)
+    if(mask & (1 << i))best = i;
+
+  use_kernels(best, mask);
+
+  const char* name = getenv("UINTX_KERNELS"); //forced variant
+  if(name)set_kernels(name);
+
+  return true;
+} //init_kernels
+
+static const bool g_bKernelsSelected = init_kernels(); ///< Selection at startup.
+
+/// Multiply a multi-word number by a single word and add the product into
+/// an accumulator using the selected variant of addmul_1_scalar().
+/// \param r [in, out] Accumulator of at least n words.
+/// \param a Multiplicand of n words.
+/// \param n Number of words in the multiplicand.
+/// \param w Single-word multiplier.
+/// \return The word carried out of the most significant end.
+
+word_t addmul_1(word_t* r, const word_t* a, uint32_t n, word_t w){
+  return g_pAddmul1(r, a, n, w);
+} //addmul_1
+
+/// Left-shift an n-word number by less than a word using the selected
+/// variant of lshift_scalar().
+/// \param r [out] Result of n words, which may start at or above the operand.
+/// \param a Operand of n words, at least 1.
+/// \param n Number of words.
+/// \param d Shift distance in bits, \f$0 \leq d <\f$ BITS_IN_WORD.
+/// \return The bits shifted out of the most significant word.
+
+word_t lshift(word_t* r, const word_t* a, uint32_t n, uint32_t d){
+  return g_pLshift(r, a, n, d);
+} //lshift
+
+/// Right-shift an n-word number by less than a word using the selected
+/// variant of rshift_scalar().
+/// \param r [out] Result of n words, which may start at or below the operand.
+/// \param a Operand of n words, at least 1.
+/// \param n Number of words.
+/// \param d Shift distance in bits, \f$0 \leq d <\f$ BITS_IN_WORD.
+/// \return The bits shifted out of the least significant word.
+
+word_t rshift(word_t* r, const word_t* a, uint32_t n, uint32_t d){
+  return g_pRshift(r, a, n, d);
+} //rshift
+
+/// Bitwise AND of two n-word numbers using the selected variant.
+/// \param r [out] Result of n words, which may be the same as either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+
+void and_n(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  g_pAnd(r, a, b, n);
+} //and_n
+
+/// Bitwise inclusive OR of two n-word numbers using the selected variant.
+/// \param r [out] Result of n words, which may be the same as either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+
+void ior_n(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  g_pIor(r, a, b, n);
+} //ior_n
+
+/// Bitwise exclusive OR of two n-word numbers using the selected variant.
+/// \param r [out] Result of n words, which may be the same as either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words.
+
+void xor_n(word_t* r, const word_t* a, const word_t* b, uint32_t n){
+  g_pXor(r, a, b, n);
+} //xor_n
+
+/// Bitwise complement of an n-word number using the selected variant.
+/// \param r [out] Result of n words, which may be the same as the operand.
+/// \param a Operand of n words.
+/// \param n Number of words.
+
+void com(word_t* r, const word_t* a, uint32_t n){
+  g_pCom(r, a, n);
+} //com
+
+#pragma endregion dispatch
@@ -0,0 +1,106 @@
+/// \file uintx_kernel.h
+/// \brief Declaration of the word-array kernels.
+///
+/// These functions operate directly on spans of words stored
+/// least-significant first, in the style of the GMP `mpn` layer. They never
+/// allocate memory, so they can be applied to any part of a number, and the
+/// caller is responsible for making the result big enough. They are the
+/// building blocks of the uintx_t operators and of the multiplication and
+/// division kernels, and are not part of the public interface. Some of
+/// them have versions for newer instruction sets that are chosen at run
+/// time, see uintx_kernel.cpp and set_kernels() in uintx_tune.h.
+
+#if !defined(__uintx_kernel__)
+#define __uintx_kernel__
+
+#include "uintx_word.h"
+
+word_t add_n(word_t*, const word_t*, const word_t*, uint32_t); ///< Addition.
+word_t sub_n(word_t*, const word_t*, const word_t*, uint32_t); ///< Subtraction.
+word_t add(word_t*, const word_t*, uint32_t, const word_t*, uint32_t); ///< Addition of unequal lengths.
+word_t sub(word_t*, const word_t*, uint32_t, const word_t*, uint32_t); ///< Subtraction of unequal lengths.
+word_t mul_1(word_t*, const word_t*, uint32_t, word_t); ///< Multiplication by a word.
+word_t addmul_1(word_t*, const word_t*, uint32_t, word_t); ///< Multiply by a word and add.
+word_t submul_1(word_t*, const word_t*, uint32_t, word_t); ///< Multiply by a word and subtract.
+word_t lshift(word_t*, const word_t*, uint32_t, uint32_t); ///< Left shift by less than a word.
+word_t rshift(word_t*, const word_t*, uint32_t, uint32_t); ///< Right shift by less than a word.
+void and_n(word_t*, const word_t*, const word_t*, uint32_t); ///< Bitwise AND.
+void ior_n(word_t*, const word_t*, const word_t*, uint32_t); ///< Bitwise inclusive OR.
+void xor_n(word_t*, const word_t*, const word_t*, uint32_t); ///< Bitwise exclusive OR.
+void com(word_t*, const word_t*, uint32_t); ///< Bitwise complement.
+int cmp(const word_t*, const word_t*, uint32_t); ///< Three-way comparison.
+word_t divrem_1(word_t*, const word_t*, uint32_t, word_t); ///< Division by a word.
+
+/// Count the leading zero bits in a word.
+/// \param w A non-zero word.
+/// \return Number of zero bits above the most significant one bit.
+
+inline uint32_t nlz(word_t w){
+  const uint32_t bits = 8*sizeof(word_t); //number of bits in a word
+  uint32_t n = 0; //number of leading zeros
+
+  for(uint32_t d=bits/2; d>0; d/=2) //binary search for the top bit
+    if((w >> (bits - d)) == 0){
+      n += d;
+      w <<= d;
+    } //if
+
+  return n;
+} //nlz
+
+/// Count the trailing zero bits in a word.
+/// \param w A non-zero word.
+/// \return Number of zero bits below the least significant one bit.
+
+inline uint32_t ntz(word_t w){
+  const uint32_t bits = 8*sizeof(word_t); //number of bits in a word
+  uint32_t n = 0; //number of trailing zeros
+
+  for(uint32_t d=bits/2; d>0; d/=2) //binary search for the bottom bit
+    if((w << (bits - d)) == 0){
+      n += d;
+      w >>= d;
+    } //if
+
+  return n;
+} //ntz
+
+/// Inverse of an odd word modulo the word radix. Every odd word is its own
+/// inverse modulo 8, and each step of Newton's iteration doubles the
+/// number of correct low bits.
+/// \param d An odd word.
+/// \return The word x such that dx = 1 modulo the word radix.
+
+inline word_t binvert(word_t d){
+  word_t x = d; //inverse correct to 3 bits
+
+  for(uint32_t b=3; b<8*sizeof(word_t); b*=2)
+    x *= 2 - d*x;
+
+  return x;
+} //binvert
+
+/// Divide a double word by a word. The quotient must fit into a word, that
+/// is, the high word of the dividend must be smaller than the divisor. With
+/// 64-bit words on x64 this is a single divq instruction, which the
+/// compiler will not use for a double-word division because it cannot
+/// know that the quotient fits.
+/// \param hi High word of the dividend.
+/// \param lo Low word of the dividend.
+/// \param d Divisor, greater than hi.
+/// \param r [out] Remainder.
+/// \return Quotient.
+
+inline word_t divw(word_t hi, word_t lo, word_t d, word_t& r){
+  #if defined(UINTX_WORD64) && defined(__x86_64__)
+    word_t q; //quotient
+    __asm__("divq %4": "=a"(q), "=d"(r): "a"(lo), "d"(hi), "rm"(d));
+    return q;
+  #else
+    const dword_t t = ((dword_t)hi << (8*sizeof(word_t))) | lo; //dividend
+    r = word_t(t%d);
+    return word_t(t/d);
+  #endif
+} //divw
+
+#endif
@@ -7,7 +7,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <utility>
 #include "uintx_t.h"
+#include "uintx_divisor.h"
+#include "uintx_montgomery.h"
 
 /// Raise an extensible unsigned integer to the power of another using
 /// successive doubling.
@@ -15,7 +18,7 @@
 /// \param z Exponent.
 /// \return The base raised to the power of the exponent.
 
-const uintx_t powx(const uintx_t& y, uint32_t z){  
+uintx_t powx(const uintx_t& y, uint32_t z){  
   if(y == uintx_t::NaN || z == uintx_t::NaN)
     return uintx_t::NaN; 
 
@@ -32,21 +35,61 @@ const uintx_t powx(const uintx_t& y, uint32_t z){
   return x;
 } //powx
 
-/// Square an extensible unsigned integer.
+/// Raise an extensible unsigned integer to the power of another modulo a
+/// third. An odd modulus uses Montgomery multiplication with a sliding
+/// window, see uintx_montgomery::pow(). An even modulus falls back to
+/// square-and-multiply with a prepared divisor, which is several times
+/// slower.
+/// \param x Base.
+/// \param e Exponent.
+/// \param m Modulus.
+/// \return The base raised to the power of the exponent, modulo the modulus,
+/// or NaN if any operand is NaN or the modulus is zero.
+
+uintx_t powmodx(const uintx_t& x, const uintx_t& e, const uintx_t& m){
+  if(x == uintx_t::NaN || e == uintx_t::NaN || m == uintx_t::NaN || m.is_zero())
+    return uintx_t::NaN;
+
+  if((to_uint32(m) & 1) == 1) //odd modulus
+    return uintx_montgomery(m).pow(x, e);
+
+  const uintx_divisor d(m); //even modulus
+  const uintx_t y = d.mod(x); //base reduced modulo m
+  const std::string bits = to_string(e, 2); //exponent in binary
+  uintx_t z(1), q; //result and quotient
+
+  for(char c: bits){
+    z *= z;
+    d.divmod(z, q, z);
+
+    if(c == '1'){
+      z *= y;
+      d.divmod(z, q, z);
+    } //if
+  } //for
+
+  return z;
+} //powmodx
+
+/// Square an extensible unsigned integer. The multiplication operator
+/// notices that both operands are the same and uses the squaring algorithm.
 /// \param x Operand.
 /// \return The operand squared.
 
-const uintx_t sqrx(const uintx_t& x){
+uintx_t sqrx(const uintx_t& x){
   return x*x;
 } //sqrx
 
 /// Compute the factorial of an extensible unsigned integer using the naive
-/// algorithm. Yes, I know that there are faster algorithms.
+/// algorithm. Yes, I know that there are faster algorithms. Space for the
+/// result is reserved up front from \f$\log_2 n! = \ln\Gamma(n+1)/\ln 2\f$
+/// so that the loop never has to reallocate.
 /// \param n Operand.
 /// \return Factorial of the operand.
 
-const uintx_t factorialx(uint32_t n){
+uintx_t factorialx(uint32_t n){
   uintx_t z(1); //result
+  z.reserve(uint32_t(std::lgamma(n + 1.0)/std::log(2.0))/(8*sizeof(word_t)) + 2);
 
   while(n > 1){
     z *= n; 
@@ -56,36 +99,16 @@ const uintx_t factorialx(uint32_t n){
   return z;
 } //factorialx
 
-/// Find the greatest common divisor of two extensible unsigned integers
-/// using Euclid's Algorithm.  Yes, I know that there are faster algorithms.
-/// \param x First operand.
-/// \param y Second operand.
-/// \return The greatest common divisor of the operands.
-
-const uintx_t gcdx(const uintx_t& x, const uintx_t& y){
-  if(x == uintx_t::NaN || y == uintx_t::NaN) //not a number
-    return uintx_t::NaN;
-
-  uintx_t w(x), z(y); //copies of parameters
-
-  //Euclid's algorithm
-
-  while(w != 0){
-    const uintx_t temp = w;
-    w = z%w; 
-    z = temp;
-  } //while
-
-  return z;
-} //gcdx
-
 /// Find the least common multiple of two extensible unsigned integers.
+/// The second operand is a multiple of the greatest common divisor, so it
+/// is divided by it with exact division, which is faster than the division
+/// operator.
 /// \param x First operand.
 /// \param y Second operand.
 /// \return The least common multiple of the operands.
 
-const uintx_t lcmx(const uintx_t& x, const uintx_t& y){
-  return x*(y/gcdx(x, y));
+uintx_t lcmx(const uintx_t& x, const uintx_t& y){
+  return x*divexactx(y, gcdx(x, y));
 } //lcmx
 
 /// Fibonacci numbers computed using successive doubling, that is, using
@@ -94,7 +117,7 @@ const uintx_t lcmx(const uintx_t& x, const uintx_t& y){
 /// \param n The index of a Fibonacci number.
 /// \return The Fibonacci number with that index, \f$F(n)\f$.
 
-const uintx_t fibx(uint32_t n){
+uintx_t fibx(uint32_t n){
   uintx_t a(0); //the result
   uintx_t b(1);
   uint32_t mask = 1 << (uint32_t)(std::floor(std::log2(n))); //most significant bit
@@ -103,13 +126,13 @@ const uintx_t fibx(uint32_t n){
     uintx_t d = a*(2*b - a);
     uintx_t e = a*a + b*b;
 
-    a = d; 
-    b = e;
+    a = std::move(d); 
+    b = std::move(e);
 
     if((mask & n) != 0){
-      const uintx_t c = a + b;
-      a = b; 
-      b = c;
+      uintx_t c = a + b;
+      a = std::move(b); 
+      b = std::move(c);
     } //if
 
     mask >>= 1;
@@ -122,7 +145,7 @@ const uintx_t fibx(uint32_t n){
 /// \param x The operand.
 /// \return Floor of the square root of the operand.
 
-const uintx_t sqrtx(const uintx_t& x){
+uintx_t sqrtx(const uintx_t& x){
   if(x == uintx_t::NaN)return x;
 
   //start by finding the most significant bit (msb) of the result.
@@ -140,8 +163,11 @@ const uintx_t sqrtx(const uintx_t& x){
   uintx_t m = n >> 1; 
   uintx_t m2 = n2 >> 2; //m^2
 
+  //the loop works in place on these so that it does not allocate memory
+
   uintx_t q = n | m;
   uintx_t q2 = n2 + ((n << (j - 1)) | m2); //q^2
+  uintx_t t; //scratch for q2
   
   while(j >= 0 && n2 != x){  
     if(q2 <= x){
@@ -151,10 +177,15 @@ const uintx_t sqrtx(const uintx_t& x){
 
     m >>= 1; 
     m2 >>= 2; 
-    q = n | m;
-
-    if(--j > 0)
-      q2 = n2 + ((n << (j - 1)) | m2); //q^2
+    q = n;
+    q |= m;
+
+    if(--j > 0){ //q2 = n2 + ((n << (j - 1)) | m2)
+      lshiftx(n, j - 1, t);
+      t |= m2;
+      q2 = n2;
+      q2 += t;
+    } //if
   } //while
   
   return n;
@@ -164,7 +195,7 @@ const uintx_t sqrtx(const uintx_t& x){
 /// \param n Exponent.
 /// \return 2 raised to the power of the exponent.
 
-const uintx_t exp2x(uint32_t n){
+uintx_t exp2x(uint32_t n){
   return uintx_t(1) << n;
 } //exp2x
 
@@ -0,0 +1,356 @@
+/// \file uintx_montgomery.cpp
+/// \brief Implementation of the Montgomery context class.
+
+#include <algorithm>
+
+#include "uintx_montgomery.h"
+#include "uintx_kernel.h"
+#include "uintx_mul.h"
+
+const uint32_t BITS_IN_WORD = 8*sizeof(word_t); ///< Number of bits in a word.
+
+/// Choose the window size for sliding-window exponentiation. Larger windows
+/// take fewer multiplications but need a bigger table of odd powers, which
+/// takes longer to fill. These are the usual crossover points, where the
+/// table costs about as much as the multiplications that it saves.
+/// \param bits Number of bits in the exponent.
+/// \return Number of bits in a window.
+
+static uint32_t windowbits(uint32_t bits){
+  if(bits > 671)return 6;
+  if(bits > 239)return 5;
+  if(bits > 79)return 4;
+  if(bits > 23)return 3;
+  return 1;
+} //windowbits
+
+/// Constructor. The constants are computed only for an odd modulus. For
+/// an even modulus, zero, or NaN, the context is left empty and pow()
+/// returns NaN.
+/// \param m Modulus.
+
+uintx_montgomery::uintx_montgomery(const uintx_t& m): m_cModulus(m){
+  if(m.m_bNaN || (m.m_pData[0] & 1) == 0)
+    return;
+
+  m_nSize = m.m_nSize;
+  m_nScratch = 4*m_nSize + std::max(mul_n_scratch(m_nSize), sqr_n_scratch(m_nSize));
+
+  m_nInverse = 0 - binvert(m.m_pData[0]);
+
+  m_cOne = (uintx_t(1) << int32_t(m_nSize*BITS_IN_WORD))%m;
+  m_cR2 = (m_cOne*m_cOne)%m;
+} //constructor
+
+/// Get the modulus.
+/// \return The modulus.
+
+const uintx_t& uintx_montgomery::modulus() const{
+  return m_cModulus;
+} //modulus
+
+/// Get the number of words in a residue in Montgomery form, which is the
+/// number of words in the modulus.
+/// \return Number of words in a residue, or zero if the modulus is not odd.
+
+uint32_t uintx_montgomery::size() const{
+  return m_nSize;
+} //size
+
+/// Get the number of words of scratch space needed by the word-level
+/// functions. This is room for a double-length product plus whatever the
+/// multiplication and squaring kernels need for a product of this size,
+/// and two more residues for load() and inverse().
+/// \return Number of words of scratch space.
+
+uint32_t uintx_montgomery::scratch_size() const{
+  return m_nScratch;
+} //scratch_size
+
+/// Copy a number less than the modulus into an array of size() words,
+/// filling the unused words at the top with zeros.
+/// \param r [out] Array of size() words.
+/// \param x Number with at most size() words.
+
+void uintx_montgomery::pad(word_t* r, const uintx_t& x) const{
+  std::copy(x.m_pData, x.m_pData + x.m_nSize, r);
+  std::fill(r + x.m_nSize, r + m_nSize, 0);
+} //pad
+
+/// Load a number into Montgomery form. It is reduced modulo the modulus
+/// first if necessary, which allocates memory, and then multiplied by
+/// \f$R^2\f$ with a Montgomery product, which does not.
+/// \param r [out] Residue of size() words.
+/// \param x Number to load.
+/// \param s Scratch space of scratch_size() words.
+
+void uintx_montgomery::load(word_t* r, const uintx_t& x, word_t* s) const{
+  const uintx_t* y = &x; //x reduced modulo the modulus
+  uintx_t t; //storage for the remainder, if needed
+
+  if(x >= m_cModulus){
+    t = x%m_cModulus;
+    y = &t;
+  } //if
+
+  pad(r, *y);
+  pad(s, m_cR2);
+  mul(r, r, s, s + m_nSize);
+} //load
+
+/// Store a residue from Montgomery form. This is a Montgomery reduction of
+/// the residue padded to double length, which leaves it divided by R.
+/// \param x [out] The number, which reuses its storage if it is big enough.
+/// \param a Residue of size() words.
+/// \param s Scratch space of scratch_size() words.
+
+void uintx_montgomery::store(uintx_t& x, const word_t* a, word_t* s) const{
+  std::copy(a, a + m_nSize, s);
+  std::fill(s + m_nSize, s + 2*m_nSize, 0);
+
+  x.resize(m_nSize);
+  reduce(x.m_pData, s);
+  x.normalize(); //remove leading zero words
+} //store
+
+/// Get one in Montgomery form, which is R mod m.
+/// \param r [out] Residue of size() words.
+
+void uintx_montgomery::one(word_t* r) const{
+  pad(r, m_cOne);
+} //one
+
+/// Montgomery reduction. Each step adds the multiple of the modulus that
+/// clears the lowest remaining word of t, and keeps the carry out of the
+/// top of that addition in the word that it has just cleared. The upper
+/// half of t plus the saved carries is then less than twice the modulus,
+/// so at most one subtraction finishes the job. This follows mpn_redc_1()
+/// in GMP.
+/// \param r [out] Result of size() words, t divided by R modulo the modulus.
+/// \param t [in, out] Number of 2*size() words less than the modulus times R,
+/// which is overwritten.
+
+void uintx_montgomery::reduce(word_t* r, word_t* t) const{
+  const uint32_t n = m_nSize; //number of words in the modulus
+  const word_t* m = m_cModulus.m_pData; //modulus
+
+  for(uint32_t i=0; i<n; i++)
+    t[i] = addmul_1(t + i, m, n, t[i]*m_nInverse);
+
+  if(add_n(r, t + n, t, n) != 0 || cmp(r, m, n) >= 0)
+    sub_n(r, r, m, n);
+} //reduce
+
+/// Sum of two residues modulo the modulus. Montgomery form is preserved
+/// by addition, so this is an ordinary modular addition. The result may be
+/// the same array as either operand.
+/// \param r [out] Result of size() words.
+/// \param a First operand of size() words.
+/// \param b Second operand of size() words.
+
+void uintx_montgomery::add(word_t* r, const word_t* a, const word_t* b) const{
+  const word_t* m = m_cModulus.m_pData; //modulus
+
+  if(add_n(r, a, b, m_nSize) != 0 || cmp(r, m, m_nSize) >= 0)
+    sub_n(r, r, m, m_nSize);
+} //add
+
+/// Difference of two residues modulo the modulus. The result may be the
+/// same array as either operand.
+/// \param r [out] Result of size() words.
+/// \param a First operand of size() words.
+/// \param b Second operand of size() words.
+
+void uintx_montgomery::sub(word_t* r, const word_t* a, const word_t* b) const{
+  if(sub_n(r, a, b, m_nSize) != 0) //wrapped around, add the modulus back
+    add_n(r, r, m_cModulus.m_pData, m_nSize);
+} //sub
+
+/// Montgomery product of two residues, that is, their product divided by R
+/// modulo the modulus. The result may be the same array as either operand.
+/// \param r [out] Result of size() words.
+/// \param a First operand of size() words.
+/// \param b Second operand of size() words.
+/// \param s Scratch space of scratch_size() words.
+
+void uintx_montgomery::mul(word_t* r, const word_t* a, const word_t* b,
+  word_t* s) const
+{
+  mul_n(s, a, b, m_nSize, s + 2*m_nSize);
+  reduce(r, s);
+} //mul
+
+/// Montgomery square of a residue. The result may be the same array as the
+/// operand.
+/// \param r [out] Result of size() words.
+/// \param a Operand of size() words.
+/// \param s Scratch space of scratch_size() words.
+
+void uintx_montgomery::sqr(word_t* r, const word_t* a, word_t* s) const{
+  sqr_n(s, a, m_nSize, s + 2*m_nSize);
+  reduce(r, s);
+} //sqr
+
+/// Inverse of a residue modulo the modulus, using the binary extended
+/// Euclidean algorithm. It keeps \f$u \equiv x_1a\f$ and
+/// \f$v \equiv x_2a \pmod m\f$, starting from \f$u = a\f$ and \f$v = m\f$,
+/// halves u and v until they are odd, halving \f$x_1\f$ and \f$x_2\f$
+/// modulo m to match, and subtracts the smaller from the larger, until
+/// \f$u = v = \gcd(a, m)\f$. This needs only shifts, additions, and
+/// subtractions in place. Since the operand is \f$aR\f$ the result is
+/// \f$a^{-1}R^{-1}\f$, which two Montgomery products by \f$R^2\f$ turn
+/// into \f$a^{-1}R\f$. The result may be the same array as the operand.
+/// \param r [out] Result of size() words.
+/// \param a Operand of size() words.
+/// \param s Scratch space of scratch_size() words.
+/// \return true if the operand has an inverse, that is, if it is coprime
+/// to the modulus, otherwise false and the result is unchanged.
+
+bool uintx_montgomery::inverse(word_t* r, const word_t* a, word_t* s) const{
+  const uint32_t n = m_nSize; //number of words in the modulus
+  const word_t* m = m_cModulus.m_pData; //modulus
+
+  word_t* u = s; //reduces to the gcd
+  word_t* v = u + n; //reduces to the gcd
+  word_t* x1 = v + n; //multiplier for u
+  word_t* x2 = x1 + n; //multiplier for v
+
+  auto half = [&](word_t* x){ //halve modulo m
+    const word_t c = (x[0] & 1) != 0? add_n(x, x, m, n): 0; //make even
+    rshift(x, x, n, 1);
+    x[n - 1] |= c << (BITS_IN_WORD - 1);
+  }; //half
+
+  std::copy(a, a + n, u);
+  std::copy(m, m + n, v);
+  std::fill(x1, x1 + n, 0);
+  std::fill(x2, x2 + n, 0);
+  x1[0] = 1;
+
+  if(std::all_of(u, u + n, [](word_t w){return w == 0;}))
+    return false; //zero has no inverse
+
+  for(;;){
+    while((u[0] & 1) == 0){
+      rshift(u, u, n, 1);
+      half(x1);
+    } //while
+
+    while((v[0] & 1) == 0){
+      rshift(v, v, n, 1);
+      half(x2);
+    } //while
+
+    const int c = cmp(u, v, n); //which is larger
+
+    if(c == 0)break;
+
+    else if(c > 0){
+      sub_n(u, u, v, n);
+      sub(x1, x1, x2);
+    } //else if
+
+    else{
+      sub_n(v, v, u, n);
+      sub(x2, x2, x1);
+    } //else
+  } //for
+
+  if(u[0] != 1 || !std::all_of(u + 1, u + n, [](word_t w){return w == 0;}))
+    return false; //gcd is not one
+
+  std::copy(x1, x1 + n, r);
+  pad(s, m_cR2);
+  mul(r, r, s, s + n);
+  mul(r, r, s, s + n);
+
+  return true;
+} //inverse
+
+/// Raise a number to a power modulo the modulus using left-to-right
+/// sliding-window exponentiation. The odd powers of the base up to the
+/// window size are computed first. Then the exponent is scanned from the
+/// top down, squaring once per bit and multiplying by a table entry once
+/// per window, where each window is a run of at most windowbits() bits that
+/// starts and ends with a one. The table, the accumulator, and the scratch
+/// space for the products all come from a single allocation.
+/// \param x Base.
+/// \param e Exponent.
+/// \return The base raised to the power of the exponent, modulo the modulus.
+
+uintx_t uintx_montgomery::pow(const uintx_t& x, const uintx_t& e) const{
+  if(m_nSize == 0 || x.m_bNaN || e.m_bNaN)
+    return uintx_t::NaN;
+
+  if(e.is_zero())
+    return m_cModulus == 1? 0: 1;
+
+  const uint32_t n = m_nSize; //number of words in a residue
+  const uint32_t bits = log2x(e) + 1; //number of bits in the exponent
+  const uint32_t k = windowbits(bits); //window size
+  const uint32_t entries = 1 << (k - 1); //number of odd powers in the table
+
+  word_t* table = new word_t[(entries + 2)*n + scratch_size()]; //odd powers
+  word_t* acc = table + entries*n; //accumulator
+  word_t* x2 = acc + n; //square of the base
+  word_t* s = x2 + n; //scratch space
+
+  auto bit = [&](uint32_t i){ //bit i of the exponent
+    return (e.m_pData[i/BITS_IN_WORD] >> (i%BITS_IN_WORD)) & 1;
+  }; //bit
+
+  //table entry j is x^(2j + 1)
+
+  load(table, x, s);
+
+  if(entries > 1){
+    sqr(x2, table, s);
+
+    for(uint32_t j=1; j<entries; j++)
+      mul(table + j*n, table + (j - 1)*n, x2, s);
+  } //if
+
+  //the top bit is one, so the first window just picks a table entry
+
+  int32_t i = bits - 1; //current bit
+  bool first = true; //nothing in the accumulator yet
+
+  while(i >= 0){
+    if(bit(i) == 0){
+      sqr(acc, acc, s);
+      --i;
+    } //if
+
+    else{
+      int32_t l = std::max(i - int32_t(k) + 1, 0); //bottom of window
+
+      while(bit(l) == 0)
+        ++l;
+
+      uint32_t w = 0; //value of window, odd
+
+      for(int32_t j=i; j>=l; j--)
+        w = 2*w + uint32_t(bit(j));
+
+      if(first){
+        std::copy(table + (w/2)*n, table + (w/2 + 1)*n, acc);
+        first = false;
+      } //if
+
+      else{
+        for(int32_t j=l; j<=i; j++)
+          sqr(acc, acc, s);
+
+        mul(acc, acc, table + (w/2)*n, s);
+      } //else
+
+      i = l - 1;
+    } //else
+  } //while
+
+  uintx_t z; //result
+  store(z, acc, s);
+  delete [] table;
+
+  return z;
+} //pow
@@ -0,0 +1,61 @@
+/// \file uintx_montgomery.h
+/// \brief Declaration of the Montgomery context class.
+
+#if !defined(__uintx_montgomery__)
+#define __uintx_montgomery__
+
+#include "uintx_t.h"
+
+/// \brief A context for arithmetic modulo a fixed odd number.
+///
+/// Montgomery multiplication replaces the division in each modular product
+/// by a reduction that only needs multiplications by words and a shift.
+/// For an n-word odd modulus m let \f$R = B^n\f$, where B is the word
+/// radix. Each residue x is kept in Montgomery form \f$xR \bmod m\f$, and
+/// the product of two residues in that form is reduced by dividing by R
+/// modulo m, which is done one word at a time by adding a multiple of m
+/// that clears the least significant word. Residues in Montgomery form
+/// are arrays of exactly n words, so the arithmetic on them never has to
+/// allocate or normalize.
+///
+/// Constructing a uintx_montgomery computes the constants needed for a
+/// given modulus once, so that it can be used for many exponentiations.
+/// The modulus must be odd. Use powmodx() in uintx_math.h if it may be
+/// even. The word-level functions can be applied to residues stored
+/// anywhere, for example packed one after another in a single array, and
+/// modx_t in modx_t.h wraps them in a residue type with operators.
+
+class uintx_montgomery{
+  private:
+    uintx_t m_cModulus; ///< The modulus.
+    uint32_t m_nSize = 0; ///< Number of words in the modulus.
+    uint32_t m_nScratch = 0; ///< Number of words of scratch space.
+    word_t m_nInverse = 0; ///< Negative of the inverse of the modulus modulo the word radix.
+    uintx_t m_cOne; ///< R mod m, that is, one in Montgomery form.
+    uintx_t m_cR2; ///< R squared mod m, for conversion to Montgomery form.
+
+    void pad(word_t*, const uintx_t&) const; ///< Copy with leading zeros.
+
+  public:
+    uintx_montgomery(const uintx_t&); ///< Constructor.
+
+    const uintx_t& modulus() const; ///< Get the modulus.
+    uint32_t size() const; ///< Number of words in a residue.
+    uint32_t scratch_size() const; ///< Number of words of scratch space.
+
+    //word-level arithmetic on residues of size() words
+
+    void load(word_t*, const uintx_t&, word_t*) const; ///< Load into Montgomery form.
+    void store(uintx_t&, const word_t*, word_t*) const; ///< Store from Montgomery form.
+    void one(word_t*) const; ///< One in Montgomery form.
+    void reduce(word_t*, word_t*) const; ///< Montgomery reduction.
+    void add(word_t*, const word_t*, const word_t*) const; ///< Sum.
+    void sub(word_t*, const word_t*, const word_t*) const; ///< Difference.
+    void mul(word_t*, const word_t*, const word_t*, word_t*) const; ///< Product.
+    void sqr(word_t*, const word_t*, word_t*) const; ///< Square.
+    bool inverse(word_t*, const word_t*, word_t*) const; ///< Inverse.
+
+    uintx_t pow(const uintx_t&, const uintx_t&) const; ///< Modular exponentiation.
+}; //uintx_montgomery
+
+#endif
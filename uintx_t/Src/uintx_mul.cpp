@@ -0,0 +1,666 @@
+/// \file uintx_mul.cpp
+/// \brief Implementation of the multiplication kernels.
+///
+/// Products of n-word operands are computed using schoolbook multiplication
+/// for small n, Karatsuba multiplication for medium n, Toom-3
+/// multiplication for large n, and number-theoretic transforms (see
+/// uintx_ntt.cpp) for very large n. Squares have their own versions of each
+/// algorithm that take advantage of the symmetry, with their own thresholds.
+/// The thresholds are set in uintx_tune.h. The recursive algorithms take
+/// their temporary storage from a single scratch buffer that is allocated
+/// once per product by mul() or sqr().
+
+#include "uintx_mul.h"
+#include "uintx_kernel.h"
+#include "uintx_tune.h"
+
+#include <algorithm>
+
+const uint32_t BITS_IN_WORD = 8*sizeof(word_t); ///< Number of bits in a word.
+const uint32_t SQR_BASECASE_MIN = 8; ///< Smallest square for sqr_basecase() proper.
+
+uint32_t g_nKaratsubaThreshold = UINTX_KARATSUBA_THRESHOLD; ///< Karatsuba threshold.
+uint32_t g_nToom3Threshold = UINTX_TOOM3_THRESHOLD; ///< Toom-3 threshold.
+uint32_t g_nNTTThreshold = UINTX_NTT_THRESHOLD; ///< NTT threshold.
+
+uint32_t g_nSqrKaratsubaThreshold = UINTX_SQR_KARATSUBA_THRESHOLD; ///< Karatsuba squaring threshold.
+uint32_t g_nSqrToom3Threshold = UINTX_SQR_TOOM3_THRESHOLD; ///< Toom-3 squaring threshold.
+uint32_t g_nSqrNTTThreshold = UINTX_SQR_NTT_THRESHOLD; ///< NTT squaring threshold.
+
+/////////////////////////////////////////////////////////////////////////////
+// Helper functions.
+
+#pragma region helpers
+
+/// Add an m-word number into an n-word accumulator, propagating the carry
+/// as far as necessary. The caller guarantees that the sum fits into n
+/// words, so any words of the addend past the end of the accumulator must
+/// be zero and are ignored, as is the final carry.
+/// \param r [in, out] Accumulator of n words.
+/// \param n Number of words in the accumulator.
+/// \param a Addend of m words.
+/// \param m Number of words in the addend.
+
+static void addto(word_t* r, uint32_t n, const word_t* a, uint32_t m){
+  add(r, r, n, a, std::min(m, n));
+} //addto
+
+/// Compute the absolute value of the difference between an n-word number
+/// and an m-word number, where \f$m \leq n\f$.
+/// \param r [out] Absolute difference of n words.
+/// \param a First operand of n words.
+/// \param n Number of words in the first operand.
+/// \param b Second operand of m words.
+/// \param m Number of words in the second operand.
+/// \return true if a is less than b.
+
+static bool absdiff(word_t* r, const word_t* a, uint32_t n,
+  const word_t* b, uint32_t m)
+{
+  uint32_t top = n; //number of significant words in a
+
+  while(top > m && a[top - 1] == 0)
+    --top;
+
+  const bool less = top == m && cmp(a, b, m) < 0;
+
+  if(less){ //the top n - m words of a are zero
+    sub_n(r, b, a, m);
+    std::fill(r + m, r + n, 0);
+  } //if
+
+  else sub(r, a, n, b, m);
+
+  return less;
+} //absdiff
+
+/// Two's complement negation of an n-word number in place.
+/// \param r [in, out] Operand of n words.
+/// \param n Number of words.
+
+static void negate(word_t* r, uint32_t n){
+  word_t carry = 1; //add one after complementing
+
+  for(uint32_t i=0; i<n; i++){
+    r[i] = ~r[i] + carry;
+    carry = carry && r[i] == 0;
+  } //for
+} //negate
+
+/// Divide an n-word number by 3 in place. The caller guarantees that the
+/// division is exact, so each quotient word can be found by multiplying by
+/// the inverse of 3 modulo \f$2^{32}\f$ (or \f$2^{64}\f$) instead of dividing,
+/// with a borrow of 0, 1, or 2 that depends on how large the word is.
+/// \param r [in, out] Operand of n words.
+/// \param n Number of words.
+
+static void divexact_by3(word_t* r, uint32_t n){
+  const word_t third = word_t(~word_t(0))/3; //0x5555...
+  const word_t inverse = 2*third + 1; //0xAAA...AB, the inverse of 3
+  word_t borrow = 0; //borrow from next word
+
+  for(uint32_t i=0; i<n; i++){
+    const word_t w = r[i];
+    const word_t d = w - borrow;
+    const word_t q = d*inverse; //quotient word
+    r[i] = q;
+    borrow = (d > w) + (q > third) + (q > 2*third);
+  } //for
+} //divexact_by3
+
+#pragma endregion helpers
+
+/////////////////////////////////////////////////////////////////////////////
+// Schoolbook multiplication.
+
+#pragma region schoolbook
+
+/// Schoolbook multiplication of an n-word number by an m-word number into
+/// an (n + m)-word result using one row of multiply-accumulates per word
+/// of the multiplier. The result must not overlap either operand. For best
+/// performance the multiplicand should be the longer of the two operands
+/// so that the inner loop runs as long as possible.
+/// \param r [out] Result of n + m words.
+/// \param a Multiplicand of n words.
+/// \param n Number of words in the multiplicand.
+/// \param b Multiplier of m words.
+/// \param m Number of words in the multiplier.
+
+static void mul_basecase(word_t* r,
+  const word_t* a, uint32_t n, const word_t* b, uint32_t m)
+{
+  for(uint32_t i=0; i<n; i++)
+    r[i] = 0; //clear the first row
+
+  for(uint32_t j=0; j<m; j++) //one row for each word of the multiplier
+    r[j + n] = addmul_1(r + j, a, n, b[j]);
+} //mul_basecase
+
+/// Schoolbook squaring of an n-word number into a 2n-word result. The
+/// product \f$a_ia_j\f$ appears twice in the square when \f$i \neq j\f$, so
+/// the products above the diagonal are computed once, doubled by a shift,
+/// and the squares on the diagonal are added in afterwards. This takes
+/// about half as many word products as mul_basecase().
+/// \param r [out] Result of 2n words, not overlapping the operand.
+/// \param a Operand of n words.
+/// \param n Number of words in the operand, at least 1.
+
+static void sqr_basecase(word_t* r, const word_t* a, uint32_t n){
+  if(n < SQR_BASECASE_MIN){ //too small for the extra passes to pay off
+    mul_basecase(r, a, n, a, n);
+    return;
+  } //if
+
+  //products above the diagonal, one row for each word but the last
+
+  r[0] = 0;
+  r[n] = mul_1(r + 1, a + 1, n - 1, a[0]);
+
+  for(uint32_t i=1; i+1<n; i++)
+    r[i + n] = addmul_1(r + 2*i + 1, a + i + 1, n - i - 1, a[i]);
+
+  r[2*n - 1] = 0;
+
+  //double them, which cannot carry out because they sum to less than half
+  //the square, and add the diagonal
+
+  lshift(r, r, 2*n, 1);
+
+  dword_t carry = 0; //carry into next word
+
+  for(uint32_t i=0; i<n; i++){
+    const dword_t t = (dword_t)a[i]*a[i]; //square on the diagonal
+    const dword_t lo = (dword_t)r[2*i] + word_t(t) + carry;
+    r[2*i] = word_t(lo);
+    const dword_t hi = r[2*i + 1] + (t >> BITS_IN_WORD) + (lo >> BITS_IN_WORD);
+    r[2*i + 1] = word_t(hi);
+    carry = hi >> BITS_IN_WORD;
+  } //for
+} //sqr_basecase
+
+#pragma endregion schoolbook
+
+/////////////////////////////////////////////////////////////////////////////
+// Recursive multiplication.
+
+#pragma region recursive
+
+/// Decide whether an n-word by m-word product should use number-theoretic
+/// transform multiplication. Products that are too long for the transform
+/// are split up by Toom-3 instead until the pieces are short enough.
+/// \param n Number of words in the longer operand.
+/// \param m Number of words in the shorter operand.
+/// \return true if NTT multiplication should be used.
+
+static bool UseNTT(uint32_t n, uint32_t m){
+  return m >= g_nNTTThreshold && n + m <= NTT_MAX_WORDS;
+} //UseNTT
+
+/// Decide whether an n-word product should use Toom-3 multiplication.
+/// Toom-3 needs at least 5 words to split into three non-empty pieces.
+/// \param n Number of words in each operand.
+/// \return true if Toom-3 should be used.
+
+static bool UseToom3(uint32_t n){
+  return n >= std::max(g_nToom3Threshold, 5U);
+} //UseToom3
+
+/// Decide whether an n-word product should use Karatsuba multiplication.
+/// Karatsuba needs at least 2 words to split into two non-empty halves.
+/// \param n Number of words in each operand.
+/// \return true if Karatsuba should be used.
+
+static bool UseKaratsuba(uint32_t n){
+  return n >= std::max(g_nKaratsubaThreshold, 2U);
+} //UseKaratsuba
+
+/// Number of words of scratch space needed by mul_n() to multiply two
+/// n-word numbers. This follows the same recursion as mul_n(). The
+/// amount needed is not monotone in n because mul_ntt() allocates its
+/// own, so every recursive call has to be taken into account.
+/// \param n Number of words in each operand.
+/// \return Number of words of scratch space.
+
+uint32_t mul_n_scratch(uint32_t n){
+  if(UseNTT(n, n))
+    return 0; //mul_ntt() allocates its own
+
+  if(UseToom3(n)){
+    const uint32_t k = (n + 2)/3; //size of each piece
+    const uint32_t next = std::max(std::max(mul_n_scratch(k + 1),
+      mul_n_scratch(k)), mul_n_scratch(n - 2*k)); //for recursive calls
+    return 6*(k + 1) + 4*(2*k + 2) + next;
+  } //if
+
+  if(UseKaratsuba(n)){
+    const uint32_t h = n - n/2; //size of high half
+    const uint32_t next = std::max(mul_n_scratch(h), mul_n_scratch(n/2));
+    return 6*h + 1 + next;
+  } //if
+
+  return 0;
+} //mul_n_scratch
+
+
+/// Karatsuba multiplication of two n-word numbers. Each operand is split
+/// into a low half of \f$\ell = \lfloor n/2 \rfloor\f$ words and a high half
+/// of \f$h = n - \ell\f$ words, \f$a = a_1B^\ell + a_0\f$ and
+/// \f$b = b_1B^\ell + b_0\f$, where B is the word radix. Then
+/// \f[ab = a_1b_1B^{2\ell} + (a_0b_0 + a_1b_1 - (a_1 - a_0)(b_1 - b_0))B^\ell
+/// + a_0b_0,\f]
+/// which takes three half-size products instead of four. The differences
+/// are computed as absolute values and their signs tracked separately
+/// so that everything stays unsigned.
+/// \param r [out] Result of 2n words, not overlapping either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words in each operand.
+/// \param s Scratch space of mul_n_scratch(n) words.
+
+static void mul_karatsuba(word_t* r, const word_t* a, const word_t* b,
+  uint32_t n, word_t* s)
+{
+  const uint32_t l = n/2; //size of low half
+  const uint32_t h = n - l; //size of high half
+
+  const word_t* a0 = a; //low half of a
+  const word_t* a1 = a + l; //high half of a
+  const word_t* b0 = b; //low half of b
+  const word_t* b1 = b + l; //high half of b
+
+  word_t* d = s; //|a1 - a0|, h words
+  word_t* e = d + h; //|b1 - b0|, h words
+  word_t* m = e + h; //d*e, 2h words
+  word_t* t = m + 2*h; //middle coefficient, 2h + 1 words
+  word_t* next = t + 2*h + 1; //scratch for recursive calls
+
+  //the product of the differences is negative when exactly one is negative
+
+  const bool neg = absdiff(d, a1, h, a0, l) != absdiff(e, b1, h, b0, l);
+
+  mul_n(m, d, e, h, next);
+  mul_n(r, a0, b0, l, next); //low product in r[0..2l)
+  mul_n(r + 2*l, a1, b1, h, next); //high product in r[2l..2n)
+
+  //middle coefficient
+
+  t[2*h] = add(t, r + 2*l, 2*h, r, 2*l); //a0*b0 + a1*b1
+
+  if(neg)add(t, t, 2*h + 1, m, 2*h);
+  else sub(t, t, 2*h + 1, m, 2*h);
+
+  addto(r + l, 2*n - l, t, 2*h + 1);
+} //mul_karatsuba
+
+/// Evaluate the polynomial \f$a_2x^2 + a_1x + a_0\f$ at the points
+/// \f$x = 1, -1, 2\f$ for Toom-3 multiplication. The value at -1 may be
+/// negative, so its absolute value is returned with the sign separately.
+/// \param p1 [out] Value at 1, k + 1 words.
+/// \param pm1 [out] Absolute value of value at -1, k + 1 words.
+/// \param p2 [out] Value at 2, k + 1 words.
+/// \param a Coefficients, 2k + k2 words, least-significant first.
+/// \param k Number of words in coefficients \f$a_0\f$ and \f$a_1\f$.
+/// \param k2 Number of words in coefficient \f$a_2\f$.
+/// \return true if the value at -1 is negative.
+
+static bool toom3_eval(word_t* p1, word_t* pm1, word_t* p2,
+  const word_t* a, uint32_t k, uint32_t k2)
+{
+  const word_t* a0 = a;
+  const word_t* a1 = a + k;
+  const word_t* a2 = a + 2*k;
+
+  p1[k] = add(p1, a0, k, a2, k2); //a0 + a2
+  const bool neg = absdiff(pm1, p1, k + 1, a1, k); //a0 - a1 + a2
+  add(p1, p1, k + 1, a1, k); //a0 + a1 + a2
+
+  std::copy(a2, a2 + k2, p2); //a2
+  std::fill(p2 + k2, p2 + k + 1, 0);
+  lshift(p2, p2, k + 1, 1); //2a2
+  add(p2, p2, k + 1, a1, k); //a1 + 2a2
+  lshift(p2, p2, k + 1, 1); //2a1 + 4a2
+  add(p2, p2, k + 1, a0, k); //a0 + 2a1 + 4a2
+
+  return neg;
+} //toom3_eval
+
+/// Interpolate and recompose the product for Toom-3 multiplication. On
+/// entry the result holds \f$c_0\f$ in its low 2k words and \f$c_4\f$ in
+/// its high 2k2 words with zeros in between, and the values of the product
+/// polynomial at 1, -1, and 2 are in fixed-width \f$(2k + 2)\f$-word two's
+/// complement. The interpolation is done in that width too, which is wide
+/// enough that the negative intermediate values wrap around and come back
+/// correctly.
+/// \param r [in, out] Result of 2n words.
+/// \param n Number of words in each operand.
+/// \param k Number of words in the low two pieces of each operand.
+/// \param k2 Number of words in the top piece of each operand.
+/// \param r1 [in, out] Value at 1, 2k + 2 words. Overwritten.
+/// \param rm1 [in, out] Value at -1, 2k + 2 words. Overwritten.
+/// \param r2 [in, out] Value at 2, 2k + 2 words. Overwritten.
+/// \param t Temporary of 2k + 2 words.
+
+static void toom3_interpolate(word_t* r, uint32_t n, uint32_t k, uint32_t k2,
+  word_t* r1, word_t* rm1, word_t* r2, word_t* t)
+{
+  const uint32_t w = 2*k + 2; //width of the interpolation values
+  const word_t* c0 = r; //c(0) = a0*b0, 2k words
+  const word_t* c4 = r + 4*k; //c(infinity) = a2*b2, 2k2 words
+
+  //interpolate
+
+  add_n(t, r1, rm1, w); //2(c0 + c2 + c4)
+  rshift(t, t, w, 1); //c0 + c2 + c4
+  sub(t, t, w, c0, 2*k);
+  sub(t, t, w, c4, 2*k2); //c2
+
+  sub_n(r1, r1, rm1, w); //2(c1 + c3)
+  rshift(r1, r1, w, 1); //c1 + c3
+
+  sub(r2, r2, w, c0, 2*k); //2c1 + 4c2 + 8c3 + 16c4
+  lshift(rm1, t, w, 2);
+  sub_n(r2, r2, rm1, w); //2c1 + 8c3 + 16c4
+  std::copy(c4, c4 + 2*k2, rm1);
+  std::fill(rm1 + 2*k2, rm1 + w, 0);
+  lshift(rm1, rm1, w, 4);
+  sub_n(r2, r2, rm1, w); //2c1 + 8c3
+  rshift(r2, r2, w, 1); //c1 + 4c3
+  sub_n(r2, r2, r1, w); //3c3
+  divexact_by3(r2, w); //c3
+  sub_n(r1, r1, r2, w); //c1
+
+  //recompose
+
+  addto(r + k, 2*n - k, r1, w);
+  addto(r + 2*k, 2*n - 2*k, t, w);
+  addto(r + 3*k, 2*n - 3*k, r2, w);
+} //toom3_interpolate
+
+/// Toom-3 multiplication of two n-word numbers. Each operand is split into
+/// three pieces of \f$k = \lceil n/3 \rceil\f$ words (the top one may be
+/// shorter) and treated as a quadratic polynomial in \f$B^k\f$. The product
+/// polynomial \f$c_4x^4 + c_3x^3 + c_2x^2 + c_1x + c_0\f$ is found from its
+/// values at \f$x = 0, 1, -1, 2, \infty\f$, which takes five products of
+/// one-third size.
+/// \param r [out] Result of 2n words, not overlapping either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words in each operand.
+/// \param s Scratch space of mul_n_scratch(n) words.
+
+static void mul_toom3(word_t* r, const word_t* a, const word_t* b,
+  uint32_t n, word_t* s)
+{
+  const uint32_t k = (n + 2)/3; //size of each piece
+  const uint32_t k2 = n - 2*k; //size of the top piece
+  const uint32_t w = 2*k + 2; //width of the interpolation values
+
+  word_t* p1  = s; //a(1)
+  word_t* pm1 = p1 + k + 1; //|a(-1)|
+  word_t* p2  = pm1 + k + 1; //a(2)
+  word_t* q1  = p2 + k + 1; //b(1)
+  word_t* qm1 = q1 + k + 1; //|b(-1)|
+  word_t* q2  = qm1 + k + 1; //b(2)
+  word_t* r1  = q2 + k + 1; //c(1)
+  word_t* rm1 = r1 + w; //c(-1)
+  word_t* r2  = rm1 + w; //c(2)
+  word_t* t   = r2 + w; //temporary
+  word_t* next = t + w; //scratch for recursive calls
+
+  //evaluate and multiply pointwise
+
+  const bool neg = toom3_eval(p1, pm1, p2, a, k, k2) !=
+    toom3_eval(q1, qm1, q2, b, k, k2);
+
+  mul_n(r1, p1, q1, k + 1, next);
+  mul_n(rm1, pm1, qm1, k + 1, next);
+  mul_n(r2, p2, q2, k + 1, next);
+  mul_n(r, a, b, k, next);
+  mul_n(r + 4*k, a + 2*k, b + 2*k, k2, next);
+  std::fill(r + 2*k, r + 4*k, 0);
+
+  if(neg)negate(rm1, w);
+
+  toom3_interpolate(r, n, k, k2, r1, rm1, r2, t);
+} //mul_toom3
+
+/// Multiply two n-word numbers using the fastest algorithm for their size.
+/// \param r [out] Result of 2n words, not overlapping either operand.
+/// \param a First operand of n words.
+/// \param b Second operand of n words.
+/// \param n Number of words in each operand.
+/// \param s Scratch space of mul_n_scratch(n) words.
+
+void mul_n(word_t* r, const word_t* a, const word_t* b,
+  uint32_t n, word_t* s)
+{
+  if(UseNTT(n, n))
+    mul_ntt(r, a, n, b, n);
+
+  else if(UseToom3(n))
+    mul_toom3(r, a, b, n, s);
+
+  else if(UseKaratsuba(n))
+    mul_karatsuba(r, a, b, n, s);
+
+  else mul_basecase(r, a, n, b, n);
+} //mul_n
+
+#pragma endregion recursive
+
+/////////////////////////////////////////////////////////////////////////////
+// Recursive squaring.
+
+#pragma region squaring
+
+/// Decide whether an n-word square should use number-theoretic transform
+/// multiplication.
+/// \param n Number of words in the operand.
+/// \return true if NTT squaring should be used.
+
+static bool UseSqrNTT(uint32_t n){
+  return n >= g_nSqrNTTThreshold && 2*n <= NTT_MAX_WORDS;
+} //UseSqrNTT
+
+/// Decide whether an n-word square should use Toom-3 squaring.
+/// \param n Number of words in the operand.
+/// \return true if Toom-3 should be used.
+
+static bool UseSqrToom3(uint32_t n){
+  return n >= std::max(g_nSqrToom3Threshold, 5U);
+} //UseSqrToom3
+
+/// Decide whether an n-word square should use Karatsuba squaring.
+/// \param n Number of words in the operand.
+/// \return true if Karatsuba should be used.
+
+static bool UseSqrKaratsuba(uint32_t n){
+  return n >= std::max(g_nSqrKaratsubaThreshold, 2U);
+} //UseSqrKaratsuba
+
+/// Number of words of scratch space needed by sqr_n() to square an n-word
+/// number. This follows the same recursion as sqr_n().
+/// \param n Number of words in the operand.
+/// \return Number of words of scratch space.
+
+uint32_t sqr_n_scratch(uint32_t n){
+  if(UseSqrNTT(n))
+    return 0; //mul_ntt() allocates its own
+
+  if(UseSqrToom3(n)){
+    const uint32_t k = (n + 2)/3; //size of each piece
+    const uint32_t next = std::max(std::max(sqr_n_scratch(k + 1),
+      sqr_n_scratch(k)), sqr_n_scratch(n - 2*k)); //for recursive calls
+    return 3*(k + 1) + 4*(2*k + 2) + next;
+  } //if
+
+  if(UseSqrKaratsuba(n)){
+    const uint32_t h = n - n/2; //size of high half
+    const uint32_t next = std::max(sqr_n_scratch(h), sqr_n_scratch(n/2));
+    return 5*h + 1 + next;
+  } //if
+
+  return 0;
+} //sqr_n_scratch
+
+
+/// Karatsuba squaring of an n-word number. With the operand split as in
+/// mul_karatsuba(),
+/// \f[a^2 = a_1^2B^{2\ell} + (a_0^2 + a_1^2 - (a_1 - a_0)^2)B^\ell + a_0^2,\f]
+/// which takes three half-size squares. The square of the difference is
+/// never negative, so there is no sign to track.
+/// \param r [out] Result of 2n words, not overlapping the operand.
+/// \param a Operand of n words.
+/// \param n Number of words in the operand.
+/// \param s Scratch space of sqr_n_scratch(n) words.
+
+static void sqr_karatsuba(word_t* r, const word_t* a, uint32_t n,
+  word_t* s)
+{
+  const uint32_t l = n/2; //size of low half
+  const uint32_t h = n - l; //size of high half
+
+  word_t* d = s; //|a1 - a0|, h words
+  word_t* m = d + h; //d^2, 2h words
+  word_t* t = m + 2*h; //middle coefficient, 2h + 1 words
+  word_t* next = t + 2*h + 1; //scratch for recursive calls
+
+  absdiff(d, a + l, h, a, l);
+
+  sqr_n(m, d, h, next);
+  sqr_n(r, a, l, next); //low square in r[0..2l)
+  sqr_n(r + 2*l, a + l, h, next); //high square in r[2l..2n)
+
+  //middle coefficient
+
+  t[2*h] = add(t, r + 2*l, 2*h, r, 2*l); //a0^2 + a1^2
+  sub(t, t, 2*h + 1, m, 2*h);
+
+  addto(r + l, 2*n - l, t, 2*h + 1);
+} //sqr_karatsuba
+
+/// Toom-3 squaring of an n-word number. This is the same as mul_toom3()
+/// except that the operand is evaluated only once and the five pointwise
+/// products are squares, which are never negative.
+/// \param r [out] Result of 2n words, not overlapping the operand.
+/// \param a Operand of n words.
+/// \param n Number of words in the operand.
+/// \param s Scratch space of sqr_n_scratch(n) words.
+
+static void sqr_toom3(word_t* r, const word_t* a, uint32_t n, word_t* s){
+  const uint32_t k = (n + 2)/3; //size of each piece
+  const uint32_t k2 = n - 2*k; //size of the top piece
+  const uint32_t w = 2*k + 2; //width of the interpolation values
+
+  word_t* p1  = s; //a(1)
+  word_t* pm1 = p1 + k + 1; //|a(-1)|
+  word_t* p2  = pm1 + k + 1; //a(2)
+  word_t* r1  = p2 + k + 1; //c(1)
+  word_t* rm1 = r1 + w; //c(-1)
+  word_t* r2  = rm1 + w; //c(2)
+  word_t* t   = r2 + w; //temporary
+  word_t* next = t + w; //scratch for recursive calls
+
+  //evaluate and square pointwise
+
+  toom3_eval(p1, pm1, p2, a, k, k2);
+
+  sqr_n(r1, p1, k + 1, next);
+  sqr_n(rm1, pm1, k + 1, next);
+  sqr_n(r2, p2, k + 1, next);
+  sqr_n(r, a, k, next);
+  sqr_n(r + 4*k, a + 2*k, k2, next);
+  std::fill(r + 2*k, r + 4*k, 0);
+
+  toom3_interpolate(r, n, k, k2, r1, rm1, r2, t);
+} //sqr_toom3
+
+/// Square an n-word number using the fastest algorithm for its size.
+/// \param r [out] Result of 2n words, not overlapping the operand.
+/// \param a Operand of n words.
+/// \param n Number of words in the operand.
+/// \param s Scratch space of sqr_n_scratch(n) words.
+
+void sqr_n(word_t* r, const word_t* a, uint32_t n, word_t* s){
+  if(UseSqrNTT(n))
+    mul_ntt(r, a, n, a, n);
+
+  else if(UseSqrToom3(n))
+    sqr_toom3(r, a, n, s);
+
+  else if(UseSqrKaratsuba(n))
+    sqr_karatsuba(r, a, n, s);
+
+  else sqr_basecase(r, a, n);
+} //sqr_n
+
+#pragma endregion squaring
+
+/// Multiply an n-word number by an m-word number. Products that are large
+/// enough go straight to mul_ntt(), which handles unbalanced operands
+/// naturally. Balanced products go straight to mul_n(). Unbalanced
+/// products are broken into m-word by m-word pieces whose products are
+/// added into the result.
+/// \param r [out] Result of n + m words, not overlapping either operand.
+/// \param a First operand of n words.
+/// \param n Number of words in the first operand.
+/// \param b Second operand of m words.
+/// \param m Number of words in the second operand.
+
+void mul(word_t* r, const word_t* a, uint32_t n,
+  const word_t* b, uint32_t m)
+{
+  if(n < m){ //make a the longer operand
+    std::swap(a, b);
+    std::swap(n, m);
+  } //if
+
+  if(UseNTT(n, m)){
+    mul_ntt(r, a, n, b, m);
+    return;
+  } //if
+
+  if(!UseKaratsuba(m) && !UseToom3(m)){ //too small to split
+    mul_basecase(r, a, n, b, m);
+    return;
+  } //if
+
+  word_t* s = new word_t[mul_n_scratch(m) + 2*m]; //scratch space
+
+  if(n == m)
+    mul_n(r, a, b, m, s);
+
+  else{
+    word_t* t = s + mul_n_scratch(m); //product of each piece, 2m words
+    std::fill(r, r + n + m, 0);
+    uint32_t i = 0; //start of current piece of a
+
+    for(; i + m <= n; i += m){
+      mul_n(t, a + i, b, m, s);
+      addto(r + i, n + m - i, t, 2*m);
+    } //for
+
+    if(i < n){ //leftover piece of fewer than m words
+      mul(t, b, m, a + i, n - i);
+      addto(r + i, n + m - i, t, m + n - i);
+    } //if
+  } //else
+
+  delete [] s;
+} //mul
+
+/// Square an n-word number.
+/// \param r [out] Result of 2n words, not overlapping the operand.
+/// \param a Operand of n words.
+/// \param n Number of words in the operand, at least 1.
+
+void sqr(word_t* r, const word_t* a, uint32_t n){
+  if(!UseSqrKaratsuba(n) && !UseSqrToom3(n)){ //too small to split
+    sqr_basecase(r, a, n);
+    return;
+  } //if
+
+  word_t* s = new word_t[sqr_n_scratch(n)]; //scratch space
+  sqr_n(r, a, n, s);
+  delete [] s;
+} //sqr
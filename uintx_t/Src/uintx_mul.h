@@ -0,0 +1,28 @@
+/// \file uintx_mul.h
+/// \brief Declaration of the multiplication kernels.
+///
+/// These functions operate directly on arrays of words stored
+/// least-significant first. They are used to implement the uintx_t
+/// multiplication operator and are not part of the public interface.
+/// They are built on the word-array kernels in uintx_kernel.h. Code that
+/// does many products of the same size, such as modular exponentiation,
+/// can allocate the scratch space once and call mul_n() and sqr_n()
+/// directly.
+
+#if !defined(__uintx_mul__)
+#define __uintx_mul__
+
+#include "uintx_word.h"
+
+const uint32_t NTT_MAX_WORDS = (1 << 26)/(sizeof(word_t)/sizeof(uint32_t)); ///< Largest product for mul_ntt(), in words.
+
+void mul(word_t*, const word_t*, uint32_t, const word_t*, uint32_t); ///< Multiplication.
+void sqr(word_t*, const word_t*, uint32_t); ///< Squaring.
+void mul_ntt(word_t*, const word_t*, uint32_t, const word_t*, uint32_t); ///< NTT multiplication.
+
+void mul_n(word_t*, const word_t*, const word_t*, uint32_t, word_t*); ///< Balanced multiplication into given scratch space.
+void sqr_n(word_t*, const word_t*, uint32_t, word_t*); ///< Squaring into given scratch space.
+uint32_t mul_n_scratch(uint32_t); ///< Scratch space needed by mul_n().
+uint32_t sqr_n_scratch(uint32_t); ///< Scratch space needed by sqr_n().
+
+#endif
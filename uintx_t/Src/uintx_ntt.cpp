@@ -0,0 +1,379 @@
+/// \file uintx_ntt.cpp
+/// \brief Implementation of number-theoretic transform multiplication.
+///
+/// Very large products are computed by convolution using a number-theoretic
+/// transform (NTT), which is a Fourier transform over the integers modulo a
+/// prime. The 32-bit digits of each operand are used as the coefficients of
+/// a polynomial. Each coefficient of the product polynomial is a sum of at
+/// most N products of two digits, so it is less than \f$N \cdot 2^{64}\f$
+/// for transforms of length N. The convolution is done modulo the three
+/// primes \f$2013265921 = 15 \cdot 2^{27} + 1\f$,
+/// \f$1811939329 = 27 \cdot 2^{26} + 1\f$, and
+/// \f$469762049 = 7 \cdot 2^{26} + 1\f$, and the results are combined
+/// using the Chinese Remainder Theorem. The largest power of two dividing
+/// \f$p - 1\f$ for all three is \f$2^{26}\f$, which allows transforms of up
+/// to \f$2^{26}\f$ points. The product of the primes is about
+/// \f$2^{90.47}\f$, which exceeds the largest coefficient
+/// \f$2^{26} \cdot 2^{64} = 2^{90}\f$ of such a transform, so each
+/// coefficient is recovered exactly. Together these limit products to
+/// \f$2^{26}\f$ digits, the limit set by NTT_MAX_WORDS in uintx_mul.h.
+/// Arithmetic modulo each prime is done in Montgomery form.
+
+#include "uintx_mul.h"
+
+#include <algorithm>
+
+const uint32_t BITS_IN_DIGIT = 32; ///< Number of bits in a digit.
+const uint32_t DIGITS_IN_WORD = sizeof(word_t)/sizeof(uint32_t); ///< Number of digits in a word.
+const uint32_t NTT_BLOCK = 1 << 12; ///< Transform values that fit in the L1 cache.
+
+/////////////////////////////////////////////////////////////////////////////
+// Modular arithmetic.
+
+#pragma region modular
+
+/// \brief A prime modulus for the number-theoretic transform.
+///
+/// A prime \f$p < 2^{31}\f$ with a primitive root g, together with the
+/// constants needed for Montgomery multiplication with \f$R = 2^{32}\f$.
+
+class CPrime{
+  public:
+    uint32_t m_nP = 0; ///< The prime.
+    uint32_t m_nG = 0; ///< A primitive root modulo the prime.
+    uint32_t m_nPInv = 0; ///< \f$-p^{-1} \bmod 2^{32}\f$.
+    uint32_t m_nR2 = 0; ///< \f$R^2 \bmod p\f$.
+
+    CPrime(uint32_t p, uint32_t g); ///< Constructor.
+
+    uint32_t add(uint32_t x, uint32_t y) const; ///< Modular addition.
+    uint32_t sub(uint32_t x, uint32_t y) const; ///< Modular subtraction.
+    uint32_t mul(uint32_t x, uint32_t y) const; ///< Montgomery multiplication.
+    uint32_t pow(uint32_t x, uint32_t e) const; ///< Modular exponentiation.
+}; //CPrime
+
+/// Constructor. Computes the Montgomery constants by Newton iteration,
+/// each step of which doubles the number of correct low-order bits.
+/// \param p A prime less than \f$2^{31}\f$.
+/// \param g A primitive root modulo p.
+
+CPrime::CPrime(uint32_t p, uint32_t g): m_nP(p), m_nG(g){
+  uint32_t inv = p; //correct to 3 bits since p is odd
+
+  for(int i=0; i<4; i++)
+    inv *= 2 - p*inv;
+
+  m_nPInv = 0 - inv;
+
+  const uint64_t r = ((uint64_t)1 << BITS_IN_DIGIT)%p; //R mod p
+  m_nR2 = uint32_t(r*r%p);
+} //constructor
+
+/// Modular addition.
+/// \param x First operand, less than p.
+/// \param y Second operand, less than p.
+/// \return \f$(x + y) \bmod p\f$.
+
+inline uint32_t CPrime::add(uint32_t x, uint32_t y) const{
+  const uint32_t s = x + y; //cannot overflow since p < 2^31
+  return s >= m_nP? s - m_nP: s;
+} //add
+
+/// Modular subtraction.
+/// \param x First operand, less than p.
+/// \param y Second operand, less than p.
+/// \return \f$(x - y) \bmod p\f$.
+
+inline uint32_t CPrime::sub(uint32_t x, uint32_t y) const{
+  return x >= y? x - y: x + m_nP - y;
+} //sub
+
+/// Montgomery multiplication.
+/// \param x First operand, less than p.
+/// \param y Second operand, less than p.
+/// \return \f$xyR^{-1} \bmod p\f$.
+
+inline uint32_t CPrime::mul(uint32_t x, uint32_t y) const{
+  const uint64_t t = (uint64_t)x*y;
+  const uint32_t m = uint32_t(t)*m_nPInv;
+  const uint32_t u = uint32_t((t + (uint64_t)m*m_nP) >> BITS_IN_DIGIT);
+  return u >= m_nP? u - m_nP: u;
+} //mul
+
+/// Modular exponentiation in ordinary (not Montgomery) form. This is only
+/// used to set up constants, so it doesn't need to be fast.
+/// \param x Base, less than p.
+/// \param e Exponent.
+/// \return \f$x^e \bmod p\f$.
+
+uint32_t CPrime::pow(uint32_t x, uint32_t e) const{
+  uint64_t result = 1;
+  uint64_t base = x;
+
+  while(e > 0){
+    if(e & 1)
+      result = result*base%m_nP;
+
+    base = base*base%m_nP;
+    e >>= 1;
+  } //while
+
+  return uint32_t(result);
+} //pow
+
+static const CPrime PRIME[3] = {
+  CPrime(2013265921, 31), //15*2^27 + 1
+  CPrime(1811939329, 13), //27*2^26 + 1
+  CPrime( 469762049,  3), //7*2^26 + 1
+}; ///< Primes for the number-theoretic transform.
+
+#pragma endregion modular
+
+/////////////////////////////////////////////////////////////////////////////
+// Number-theoretic transform.
+
+#pragma region transform
+
+/// Fill in the table of roots of unity for a transform of length n.
+/// The roots for the butterflies of half-size h are stored in positions h
+/// through 2h - 1, in Montgomery form, so that each pass of the transform
+/// reads them sequentially.
+/// \param p Prime modulus.
+/// \param w [out] Table of n roots of unity.
+/// \param n Transform length, a power of 2.
+/// \param inverse true for the inverse transform.
+
+static void roots(const CPrime& p, uint32_t* w, uint32_t n, bool inverse){
+  for(uint32_t h=1; h<n; h<<=1){
+    uint32_t root = p.pow(p.m_nG, (p.m_nP - 1)/(2*h)); //primitive 2h-th root
+
+    if(inverse)
+      root = p.pow(root, p.m_nP - 2);
+
+    root = p.mul(root, p.m_nR2); //to Montgomery form
+    uint32_t x = p.mul(1, p.m_nR2); //1 in Montgomery form
+
+    for(uint32_t j=0; j<h; j++){
+      w[h + j] = x;
+      x = p.mul(x, root);
+    } //for
+  } //for
+} //roots
+
+/// Forward transform butterflies of half-size h over a block of n values.
+/// \param p Prime modulus.
+/// \param x [in, out] Array of n values less than p.
+/// \param w Table of roots of unity from roots().
+/// \param n Block length, a multiple of 2h.
+/// \param h Half-size of butterflies.
+
+static void forward_pass(const CPrime p, uint32_t* x, const uint32_t* w,
+  uint32_t n, uint32_t h)
+{
+  for(uint32_t s=0; s<n; s+=2*h)
+    for(uint32_t j=0; j<h; j++){
+      const uint32_t u = x[s + j];
+      const uint32_t v = x[s + j + h];
+      x[s + j] = p.add(u, v);
+      x[s + j + h] = p.mul(p.sub(u, v), w[h + j]);
+    } //for
+} //forward_pass
+
+/// Inverse transform butterflies of half-size h over a block of n values.
+/// \param p Prime modulus.
+/// \param x [in, out] Array of n values less than p.
+/// \param w Table of inverse roots of unity from roots().
+/// \param n Block length, a multiple of 2h.
+/// \param h Half-size of butterflies.
+
+static void inverse_pass(const CPrime p, uint32_t* x, const uint32_t* w,
+  uint32_t n, uint32_t h)
+{
+  for(uint32_t s=0; s<n; s+=2*h)
+    for(uint32_t j=0; j<h; j++){
+      const uint32_t u = x[s + j];
+      const uint32_t v = p.mul(x[s + j + h], w[h + j]);
+      x[s + j] = p.add(u, v);
+      x[s + j + h] = p.sub(u, v);
+    } //for
+} //inverse_pass
+
+/// Forward transform using decimation in frequency. The input is in
+/// natural order and the output is in bit-reversed order. Once the
+/// butterflies are small enough, the remaining passes are done one
+/// cache-sized block at a time instead of sweeping the whole array.
+/// \param p Prime modulus.
+/// \param x [in, out] Array of n values less than p.
+/// \param w Table of roots of unity from roots().
+/// \param n Transform length, a power of 2.
+
+static void forward(const CPrime& p, uint32_t* x, const uint32_t* w, uint32_t n){
+  const uint32_t block = std::min(n, NTT_BLOCK); //block length
+  
+  for(uint32_t h=n/2; h>=block; h>>=1)
+    forward_pass(p, x, w, n, h);
+
+  for(uint32_t i=0; i<n; i+=block)
+    for(uint32_t h=block/2; h>=1; h>>=1)
+      forward_pass(p, x + i, w, block, h);
+} //forward
+
+/// Inverse transform using decimation in time, without the final division
+/// by n. The input is in bit-reversed order and the output is in natural
+/// order. The small butterflies are done one cache-sized block at a time.
+/// \param p Prime modulus.
+/// \param x [in, out] Array of n values less than p.
+/// \param w Table of inverse roots of unity from roots().
+/// \param n Transform length, a power of 2.
+
+static void inverse(const CPrime& p, uint32_t* x, const uint32_t* w, uint32_t n){
+  const uint32_t block = std::min(n, NTT_BLOCK); //block length
+
+  for(uint32_t i=0; i<n; i+=block)
+    for(uint32_t h=1; h<block; h<<=1)
+      inverse_pass(p, x + i, w, block, h);
+
+  for(uint32_t h=block; h<n; h<<=1)
+    inverse_pass(p, x, w, n, h);
+} //inverse
+
+/// Load an n-word number into a transform buffer as coefficients modulo p,
+/// one for each digit, padding with zeros to the transform length.
+/// \param p Prime modulus.
+/// \param x [out] Transform buffer of len values.
+/// \param len Transform length.
+/// \param a Operand of n words.
+/// \param n Number of words in the operand.
+
+static void load(const CPrime& p, uint32_t* x, uint32_t len,
+  const word_t* a, uint32_t n)
+{
+  for(uint32_t i=0; i<n*DIGITS_IN_WORD; i++){
+    const uint32_t shift = BITS_IN_DIGIT*(i%DIGITS_IN_WORD); //position in word
+    x[i] = uint32_t(a[i/DIGITS_IN_WORD] >> shift)%p.m_nP;
+  } //for
+
+  std::fill(x + n*DIGITS_IN_WORD, x + len, 0);
+} //load
+
+/// Compute a cyclic convolution modulo a prime. If the operands are the
+/// same then only one forward transform is needed, which saves a third of
+/// the work when squaring.
+/// \param p Prime modulus.
+/// \param x [out] Convolution, len values.
+/// \param t Temporary buffer, len values.
+/// \param w Temporary buffer for the roots of unity, len values.
+/// \param len Transform length.
+/// \param a First operand of n words.
+/// \param n Number of words in the first operand.
+/// \param b Second operand of m words.
+/// \param m Number of words in the second operand.
+
+static void convolve(const CPrime& p, uint32_t* x, uint32_t* t, uint32_t* w,
+  uint32_t len, const word_t* a, uint32_t n, const word_t* b, uint32_t m)
+{
+  roots(p, w, len, false);
+
+  load(p, x, len, a, n);
+  forward(p, x, w, len);
+
+  const bool square = a == b && n == m; //whether the operands are the same
+
+  if(!square){
+    load(p, t, len, b, m);
+    forward(p, t, w, len);
+  } //if
+
+  const uint32_t* y = square? x: t; //transform of the second operand
+
+  //pointwise product, which picks up a factor of 1/R, then divide by len
+  //in advance of the inverse transform and cancel the factors of 1/R
+  //from both multiplications
+
+  const uint32_t scale = p.mul(p.mul(p.pow(len, p.m_nP - 2), p.m_nR2), p.m_nR2);
+
+  for(uint32_t i=0; i<len; i++)
+    x[i] = p.mul(p.mul(x[i], y[i]), scale);
+
+  roots(p, w, len, true);
+  inverse(p, x, w, len);
+} //convolve
+
+#pragma endregion transform
+
+/// Multiply an n-word number by an m-word number using number-theoretic
+/// transforms modulo three primes. The product coefficients are
+/// reconstructed from their residues by Garner's algorithm and the carries
+/// are propagated as they are written to the result. Squaring, signalled
+/// by passing the same operand twice, takes two transforms per prime
+/// instead of three.
+/// \param r [out] Result of n + m words, not overlapping either operand.
+/// \param a First operand of n words.
+/// \param n Number of words in the first operand.
+/// \param b Second operand of m words.
+/// \param m Number of words in the second operand.
+
+void mul_ntt(word_t* r, const word_t* a, uint32_t n,
+  const word_t* b, uint32_t m)
+{
+  const uint32_t digits = (n + m)*DIGITS_IN_WORD; //digits in the product
+  uint32_t len = 1; //transform length
+
+  while(len < digits - 1)
+    len <<= 1;
+
+  uint32_t* buffer = new uint32_t[5*len]; //convolutions and temporaries
+  uint32_t* x[3] = {buffer, buffer + len, buffer + 2*len}; //convolutions
+
+  for(int i=0; i<3; i++)
+    convolve(PRIME[i], x[i], buffer + 3*len, buffer + 4*len, len, a, n, b, m);
+
+  //constants for Garner's algorithm
+
+  const uint32_t p0 = PRIME[0].m_nP;
+  const uint32_t p1 = PRIME[1].m_nP;
+  const uint64_t p01 = (uint64_t)p0*p1;
+
+  const uint32_t inv0 = PRIME[1].pow(p0%p1, p1 - 2); //p0^-1 mod p1
+  const uint32_t inv01 = PRIME[2].pow(uint32_t(p01%PRIME[2].m_nP),
+    PRIME[2].m_nP - 2); //(p0*p1)^-1 mod p2
+
+  //reconstruct each coefficient from its residues as
+  //v0 + v1*p0 + v2*p0*p1 and add it to the result with carry
+
+  uint64_t c0 = 0, c1 = 0; //carry, c0 + c1*2^32
+
+  for(uint32_t i=0; i<digits; i++){
+    uint64_t x0 = 0, x1 = 0, x2 = 0; //coefficient, three 32-bit digits
+
+    if(i < digits - 1){
+      const CPrime& q1 = PRIME[1];
+      const CPrime& q2 = PRIME[2];
+
+      const uint32_t v0 = x[0][i];
+      const uint32_t v1 = uint32_t((uint64_t)q1.sub(x[1][i], v0%p1)*inv0%p1);
+
+      const uint64_t t = v0 + (uint64_t)v1*p0; //less than p0*p1
+      const uint32_t v2 = uint32_t((uint64_t)q2.sub(x[2][i],
+        uint32_t(t%q2.m_nP))*inv01%q2.m_nP);
+
+      const uint64_t lo = (uint64_t)uint32_t(p01)*v2; //low half of p01*v2
+      const uint64_t hi = (p01 >> BITS_IN_DIGIT)*v2; //high half of p01*v2
+      const uint64_t mid = (lo >> BITS_IN_DIGIT) + uint32_t(hi) + (t >> BITS_IN_DIGIT);
+
+      x0 = uint32_t(lo) + uint64_t(uint32_t(t));
+      x1 = uint32_t(mid) + (x0 >> BITS_IN_DIGIT);
+      x2 = (mid >> BITS_IN_DIGIT) + (hi >> BITS_IN_DIGIT);
+      x0 = uint32_t(x0);
+    } //if
+
+    const uint64_t s = c0 + x0;
+    const uint32_t shift = BITS_IN_DIGIT*(i%DIGITS_IN_WORD); //position in word
+    if(shift == 0)r[i/DIGITS_IN_WORD] = 0;
+    r[i/DIGITS_IN_WORD] |= word_t(uint32_t(s)) << shift;
+    c0 = (s >> BITS_IN_DIGIT) + c1 + x1;
+    c1 = x2;
+  } //for
+
+  delete [] buffer;
+} //mul_ntt
@@ -2,17 +2,88 @@
 /// \brief Implementation of the extensible unsigned integer class.
 
 #include "uintx_t.h"
+#include "uintx_mul.h"
+#include "uintx_div.h"
+#include "uintx_gcd.h"
+#include "uintx_kernel.h"
 
 #include <cmath>
+#include <cstring>
 #include <algorithm>
+#include <utility>
+#include <vector>
 
-const uint32_t BYTES_IN_WORD = sizeof(uint32_t); ///< Number of bytes in a word.
+const uint32_t BYTES_IN_WORD = sizeof(word_t); ///< Number of bytes in a word.
 const uint32_t NIBS_IN_WORD = 2*BYTES_IN_WORD; ///< Number of nibbles in a word.
 const uint32_t BITS_IN_WORD = 4*NIBS_IN_WORD; ///< Number of bits in a word.
 const uint32_t MSB = BITS_IN_WORD - 1; ///< Position of most significant bit.
-
+const uint32_t WORDS_IN_UINT64 = sizeof(uint64_t)/BYTES_IN_WORD; ///< Number of words in a uint64_t.
+const word_t WORD_MAX = ~word_t(0); ///< Largest word.
+const word_t LOW_32_BITS = word_t(0xFFFFFFFFU); ///< Low 32 bits of a word, which is all of it for 32-bit words.
+
+const uint32_t STRING_THRESHOLD = 32; ///< Words at which string conversion starts to divide and conquer.
+const uint32_t STRING_CACHE_WORDS = 4096; ///< Largest power of a base kept between string conversions, in words.
+const char DIGITS[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ"; ///< Digits for bases up to 36.
+
+/// Value of each character as a hex digit, or 0xFF if it is not one.
+
+const uint8_t HEX_VALUE[256] = {
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+  0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF
+}; //HEX_VALUE
+
+/// The two hex digits of each byte, most significant first.
+
+const char HEX_PAIRS[] =
+  "000102030405060708090A0B0C0D0E0F"
+  "101112131415161718191A1B1C1D1E1F"
+  "202122232425262728292A2B2C2D2E2F"
+  "303132333435363738393A3B3C3D3E3F"
+  "404142434445464748494A4B4C4D4E4F"
+  "505152535455565758595A5B5C5D5E5F"
+  "606162636465666768696A6B6C6D6E6F"
+  "707172737475767778797A7B7C7D7E7F"
+  "808182838485868788898A8B8C8D8E8F"
+  "909192939495969798999A9B9C9D9E9F"
+  "A0A1A2A3A4A5A6A7A8A9AAABACADAEAF"
+  "B0B1B2B3B4B5B6B7B8B9BABBBCBDBEBF"
+  "C0C1C2C3C4C5C6C7C8C9CACBCCCDCECF"
+  "D0D1D2D3D4D5D6D7D8D9DADBDCDDDEDF"
+  "E0E1E2E3E4E5E6E7E8E9EAEBECEDEEEF"
+  "F0F1F2F3F4F5F6F7F8F9FAFBFCFDFEFF";
+
+const uint32_t uintx_t::LOCAL_SIZE; ///< Number of words in local storage.
 const uintx_t uintx_t::NaN(-1); ///< Extensible unsigned integer not-a-number.
 
+/// Split a 64-bit unsigned integer into words, least significant first.
+/// \param y A 64-bit unsigned integer.
+/// \param w [out] Array of WORDS_IN_UINT64 words.
+/// \return Number of words needed for y, at least 1.
+
+static uint32_t split(uint64_t y, word_t* w){
+  w[0] = word_t(y);
+
+  if(y <= WORD_MAX)
+    return 1;
+
+  w[WORDS_IN_UINT64 - 1] = word_t(y >> 32); //only with 32-bit words
+  return WORDS_IN_UINT64;
+} //split
+
 /////////////////////////////////////////////////////////////////////////////
 //Constructors and destructors.
 
@@ -27,7 +98,6 @@ uintx_t::uintx_t(): uintx_t(0){
 /// \param i Initial value.
 
 uintx_t::uintx_t(uint32_t i){ 
-  m_pData = new uint32_t[1]; 
   m_nSize = 1;
   m_pData[0] = i;
 } //uint32_t constructor
@@ -36,7 +106,6 @@ uintx_t::uintx_t(uint32_t i){
 /// \param i Initial value.
 
 uintx_t::uintx_t(int32_t i){ 
-  m_pData = new uint32_t[1]; 
   m_nSize = 1;
 
   if(i >= 0)
@@ -52,17 +121,15 @@ uintx_t::uintx_t(int32_t i){
 /// \param i Initial value.
 
 uintx_t::uintx_t(uint64_t i){ 
-  if(i > 0xFFFFFFFF){
-    m_pData = new uint32_t[2]; 
+  if(i > WORD_MAX){ //two 32-bit words
     m_nSize = 2;
-    m_pData[0] = uint32_t(i) & 0xFFFFFFFF;
-    m_pData[1] = uint32_t(i >> 32);
+    m_pData[0] = word_t(i);
+    m_pData[1] = word_t(i >> 32);
   } //if
 
   else{
-    m_pData = new uint32_t[1]; 
     m_nSize = 1;
-    m_pData[0] = uint32_t(i);
+    m_pData[0] = word_t(i);
   } //else
 } //uint64_t constructor
   
@@ -74,7 +141,6 @@ uintx_t::uintx_t(int64_t i){
     *this = uintx_t(uint64_t(i));
 
   else{ //negative number supplied
-    m_pData = new uint32_t[1]; 
     m_nSize = 1;
     m_pData[0] = 0;
     m_bNaN = true;
@@ -100,17 +166,43 @@ uintx_t::uintx_t(const char* s){
 
 uintx_t::uintx_t(const uintx_t& x){ 
   m_nSize = x.m_nSize;
-  m_pData = new uint32_t[m_nSize]; //grab space
+  m_pData = allocate(m_nSize); //grab space
+  m_nCapacity = std::max(m_nSize, LOCAL_SIZE);
   m_bNaN = x.m_bNaN;
 
   for(uint32_t i=0; i<m_nSize; i++)
     m_pData[i] = x.m_pData[i]; //load m_pData
 } //copy constructor
 
+/// Move constructor. A heap buffer is taken from the operand instead of
+/// being copied, and the operand is left equal to zero. A value held in
+/// local storage is simply copied.
+/// \param x Extensible unsigned integer to be moved.
+
+uintx_t::uintx_t(uintx_t&& x){ 
+  m_nSize = x.m_nSize;
+  m_bNaN = x.m_bNaN;
+
+  if(x.m_pData == x.m_pLocal) //small value
+    for(uint32_t i=0; i<m_nSize; i++)
+      m_pData[i] = x.m_pData[i]; //copy into local storage
+
+  else{ //take the heap buffer
+    m_pData = x.m_pData;
+    m_nCapacity = x.m_nCapacity;
+
+    x.m_pData = x.m_pLocal;
+    x.m_nCapacity = LOCAL_SIZE;
+    x.m_pLocal[0] = 0;
+    x.m_nSize = 1;
+    x.m_bNaN = false;
+  } //else
+} //move constructor
+
 /// Destructor.
 
 uintx_t::~uintx_t(){ 
-  delete [] m_pData; 
+  release(m_pData); 
   m_pData = nullptr; //safety
 } //destructor
 
@@ -121,65 +213,119 @@ uintx_t::~uintx_t(){
 
 #pragma region memory
 
-/// Change the number of words allocated and zero out the value stored.
-/// \param size Number of words to allocate.
+/// Get space for a number of words. Small amounts come from local storage
+/// rather than the heap.
+/// \param size Number of words.
+/// \return Pointer to the space.
 
-void uintx_t::reallocate(const uint32_t size){ 
-  if(m_nSize != size){ //if change needed
-    m_nSize = size; 
-    delete [] m_pData; //get rid of old space
-    m_pData = new uint32_t[size]; //get new space
+word_t* uintx_t::allocate(const uint32_t size){ 
+  return size <= LOCAL_SIZE? m_pLocal: new word_t[size];
+} //allocate
 
+/// Give back space obtained from allocate(). Local storage is left alone.
+/// \param p Pointer to the space.
+
+void uintx_t::release(word_t* p){ 
+  if(p != m_pLocal)
+    delete [] p;
+} //release
+
+/// Move the value stored into a buffer with room for a given number of
+/// words. Local storage is used if it is big enough.
+/// \param capacity New capacity in words, at least m_nSize.
+
+void uintx_t::recapacity(const uint32_t capacity){ 
+  word_t* olddata = m_pData; //old m_pData
+  m_pData = allocate(capacity); //grab new space
+
+  if(m_pData != olddata){ //not still in local storage
     for(uint32_t i=0; i<m_nSize; i++)
-      m_pData[i] = 0; //zero it out
+      m_pData[i] = olddata[i]; //copy over old digits
+
+    release(olddata); //recycle old space
+  } //if
+
+  m_nCapacity = std::max(capacity, LOCAL_SIZE);
+} //recapacity
+
+/// Change the number of words used and zero out the value stored. New
+/// space is allocated only if the current capacity is too small.
+/// \param size Number of words to use.
+
+void uintx_t::reallocate(const uint32_t size){ 
+  if(size > m_nCapacity){ //if more space needed
+    m_nSize = 0; //nothing worth copying
+    recapacity(size);
   } //if
+
+  m_nSize = size; 
+
+  for(uint32_t i=0; i<m_nSize; i++)
+    m_pData[i] = 0; //zero it out
 } //reallocate
 
-/// Increase the amount of space allocated while keeping the value stored.
+/// Increase the number of words used while keeping the value stored. If
+/// the current capacity is too small then it is increased geometrically
+/// so that repeated growth takes amortized constant time per word.
 /// \param size New size in words.
 
 void uintx_t::grow(const uint32_t size){
   if(m_nSize < size){ //if really an increase in m_nSize
-    uint32_t* olddata = m_pData; //old m_pData
-    uint32_t oldsize = m_nSize; //old m_nSize
+    if(size > m_nCapacity) //need more space
+      recapacity(std::max(size, m_nCapacity + m_nCapacity/2));
 
-    m_pData = new uint32_t[size]; //grab new space
-    m_nSize = size; 
-    
-    uint32_t i; 
+    for(uint32_t i=m_nSize; i<size; i++)
+      m_pData[i] = 0; //zero out the new words
 
-    for(i=0; i<oldsize; i++)
-      m_pData[i] = olddata[i]; //copy over old digits
+    m_nSize = size; 
+  } //if
+} //grow
 
-    for(; i<m_nSize; i++)
-      m_pData[i] = 0; //zero out the rest
+/// Change the number of words used without keeping the value stored, for
+/// a result that is about to be overwritten. New space is allocated only if
+/// the current capacity is too small. The result is not NaN.
+/// \param size Number of words to use.
 
-    delete [] olddata; //recycle old space
+void uintx_t::resize(const uint32_t size){ 
+  if(size > m_nCapacity){ //if more space needed
+    m_nSize = 0; //nothing worth copying
+    recapacity(size);
   } //if
-} //grow
 
-/// Minimize the amount of storage by removing the leading zero words
-/// and reallocating a smaller amount of space if possible.
+  m_nSize = size;
+  m_bNaN = false;
+} //resize
+
+/// Remove the leading zero words. The space they occupied is kept for
+/// later growth, use shrink_to_fit() to give it back.
 
 void uintx_t::normalize(){
-  uint32_t* olddata = m_pData; //old m_pData
-  int32_t top = m_nSize - 1;
+  while(m_nSize > 1 && m_pData[m_nSize - 1] == 0)
+    m_nSize--;
+} //normalize
 
-  while(top > 0 && m_pData[top] == 0)
-    top--;
+/// Make sure that there is space for at least a given number of words, so
+/// that the value can grow to that size without reallocating.
+/// \param size Number of words.
 
-  top = std::max(0, top);
+void uintx_t::reserve(const uint32_t size){
+  if(size > m_nCapacity)
+    recapacity(size);
+} //reserve
 
-  if((uint32_t)top < m_nSize - 1){ //change is needed
-    m_nSize = top + 1; //new size
-    m_pData = new uint32_t[m_nSize]; //grab new space
+/// Give back any space not needed for the value stored.
 
-    for(int32_t i=0; i<=top; i++) //copy over old digits
-      m_pData[i] = olddata[i];
+void uintx_t::shrink_to_fit(){
+  if(m_nCapacity > std::max(m_nSize, LOCAL_SIZE))
+    recapacity(m_nSize);
+} //shrink_to_fit
 
-    delete [] olddata; //recycle old space
-  } //if
-} //normalize
+/// Get the capacity.
+/// \return Number of words that the value can grow to without reallocating.
+
+uint32_t uintx_t::capacity() const{
+  return m_nCapacity;
+} //capacity
 
 #pragma endregion memory
 
@@ -190,62 +336,53 @@ void uintx_t::normalize(){
 
 /// Set to a hex value contained in an std::string. Both lower-case and
 /// upper case letters are allowed. 0x at the start of the string is optional. 
-/// Gets set to NaN if there's an unexpected character in the string.
+/// Gets set to NaN if there's an unexpected character in the string. Leading
+/// zeros are allowed but do not take up any space. The words are filled
+/// directly, least significant first, a word of digits at a time from the
+/// end of the string. Each character is looked up in a table whose entries
+/// for non-hex characters have the top bit set, and the entries are OR-ed
+/// together so that bad characters are found at the end without a branch
+/// per character.
 /// \param s An std::string containing a hex value.
 
 void uintx_t::loadstring(const std::string& s){ 
-  m_bNaN = false;  
-  
-  const size_t start = (s[0] == '0' && s[1] == 'x')? 2: 0; //skip 0x if present
-  const size_t n = s.size() - start;
-  const uint32_t nSize = (uint32_t)std::ceil((double)n/NIBS_IN_WORD);
-
-  if(nSize != m_nSize){
-    delete [] m_pData;
-    m_nSize = nSize;
-    m_pData = new uint32_t[m_nSize]; //grab space
-  } //if
-
-  for(uint32_t i=0; i<m_nSize; i++)
-    m_pData[i] = 0; //clear m_pData
-
-  uint32_t word = m_nSize - 1; //current word in long integer
-  const size_t digitcount = n; //number of digits in string
-
-  uint32_t shift = (digitcount%NIBS_IN_WORD)*4; //shift within word
-  if(shift <= 0)shift = BITS_IN_WORD; //wrap shift amount
-
-  m_bNaN = false; //optimistically we believe that this is a number
-
-  for(size_t j=0; j<digitcount && !m_bNaN; j++){ //load each digit from string
-    const size_t i = j + start; //current index
-    uint32_t digit = 0; //current digit
-
-    //get current digit from hex character
-
-    if(s[i] >= '0' && s[i] <='9') //0-9
-      digit = s[i] - '0';
-
-    else if(s[i] >= 'A' && s[i] <= 'F') //A-F
-      digit = 10 + s[i] - 'A';
+  const size_t start = (s.size() >= 2 && s[0] == '0' && s[1] == 'x')? 2: 0; //skip 0x if present
+  const char* first = s.data() + start; //first digit
+  const char* last = s.data() + s.size(); //one past the next digit, working backwards
+  const size_t n = last - first; //number of digits
+
+  const uint32_t full = uint32_t(n/NIBS_IN_WORD); //number of full words
+  resize(std::max(uint32_t((n + NIBS_IN_WORD - 1)/NIBS_IN_WORD), 1U));
+  uint8_t bad = 0; //top bit is set if there's a non-hex character
+
+  for(uint32_t i=0; i<full; i++){ //for each full word, least significant first
+    last -= NIBS_IN_WORD;
+    word_t w = 0; //current word
+
+    for(uint32_t j=0; j<NIBS_IN_WORD; j++){ //for each digit
+      const uint8_t v = HEX_VALUE[uint8_t(last[j])]; //value of digit
+      bad |= v;
+      w |= word_t(v & 0xF) << 4*(NIBS_IN_WORD - 1 - j);
+    } //for
 
-    else if(s[i] >= 'a' && s[i] <= 'f') //a-f
-      digit = 10 + s[i] - 'a';
+    m_pData[i] = w;
+  } //for
 
-    else m_bNaN = true; //non-hex character encountered
+  if(full < m_nSize){ //partial or empty most significant word
+    word_t w = 0; //current word
 
-    //put digit into m_pData
+    for(const char* p=first; p<last; p++){ //for each digit
+      const uint8_t v = HEX_VALUE[uint8_t(*p)]; //value of digit
+      bad |= v;
+      w = (w << 4) | (v & 0xF);
+    } //for
 
-    if(!m_bNaN){
-      if(shift <= 0){
-        shift = BITS_IN_WORD;
-        word--;
-      } //if
+    m_pData[full] = w;
+  } //if
 
-      shift -=  4;
-      m_pData[word] |= digit << shift;
-    } //if
-  } //for
+  if(bad & 0x80) //non-hex character
+    *this = NaN;
+  else normalize(); //remove leading zero words
 } //loadstring
 
 #pragma endregion helpers
@@ -258,9 +395,9 @@ void uintx_t::loadstring(const std::string& s){
 /// \return Floor of the log base 2 of the operand.
 
 const uint32_t log2x(const uintx_t& x){
-  if(x.m_bNaN || x == 0)return 0;
+  if(x.m_bNaN || x.is_zero())return 0;
 
-  uint32_t word = x.m_pData[x.m_nSize - 1]; //most significant word in x
+  word_t word = x.m_pData[x.m_nSize - 1]; //most significant word in x
   uint32_t count = 0; //counter
 
   while(word > 0){
@@ -271,6 +408,14 @@ const uint32_t log2x(const uintx_t& x){
   return count + (x.m_nSize - 1)*BITS_IN_WORD - 1;
 } //log2x
 
+/// Zero test, which is faster than comparing against zero. Assumes that
+/// the operand is normalized.
+/// \return true If this is zero, false if it is non-zero or NaN.
+
+bool uintx_t::is_zero() const{
+  return !m_bNaN && m_nSize == 1 && m_pData[0] == 0;
+} //is_zero
+
 /////////////////////////////////////////////////////////////////////////////
 //Assignment operators.
 
@@ -291,6 +436,41 @@ uintx_t& uintx_t::operator=(const uintx_t& x){
   return *this;
 } //operator=
 
+/// Move assignment operator. If the operand is on the heap then its buffer
+/// is taken instead of copied. If this value was on the heap too then the
+/// buffers are swapped, so the operand gets the old value's storage and
+/// frees it when it is destroyed. Otherwise the operand is left equal to
+/// zero. Small values held in local storage are simply copied.
+/// \param x Operand.
+/// \return Reference after assignment.
+
+uintx_t& uintx_t::operator=(uintx_t&& x){ 
+  if(x.m_pData == x.m_pLocal) //small value
+    return *this = x; //copy it
+
+  m_bNaN = x.m_bNaN;
+
+  if(m_pData != m_pLocal){ //both on the heap
+    std::swap(m_pData, x.m_pData);
+    std::swap(m_nSize, x.m_nSize);
+    std::swap(m_nCapacity, x.m_nCapacity);
+  } //if
+
+  else{ //take the operand's buffer
+    m_pData = x.m_pData;
+    m_nSize = x.m_nSize;
+    m_nCapacity = x.m_nCapacity;
+
+    x.m_pData = x.m_pLocal;
+    x.m_nCapacity = LOCAL_SIZE;
+    x.m_pLocal[0] = 0;
+    x.m_nSize = 1;
+    x.m_bNaN = false;
+  } //else
+
+  return *this;
+} //operator=
+
 #pragma endregion assignment
 
 /////////////////////////////////////////////////////////////////////////////
@@ -303,12 +483,15 @@ uintx_t& uintx_t::operator=(const uintx_t& x){
 /// \param y Second operand.
 /// \return The sum of the two operands.
 
-const uintx_t operator+(const uintx_t& x, const uintx_t& y){
+uintx_t operator+(const uintx_t& x, const uintx_t& y){
   uintx_t result = x;
-  return result += y;
+  result += y;
+  return result;
 } //operator+
 
-/// Add a extensible unsigned integer.
+/// Add a extensible unsigned integer. This is done by add() with the
+/// longer operand first, which stops early if that is this one and the
+/// carry dies out.
 /// \param y Operand.
 /// \return Reference after addition.
 
@@ -317,58 +500,154 @@ uintx_t& uintx_t::operator+=(const uintx_t& y){
     m_bNaN = true;
 
   if(!m_bNaN){
-    uint32_t left, right, left_msb, right_msb; //operands and their msb's
-    uint32_t sum, sum_msb; //sum and its msb
-    uint32_t carry = 0; //single-bit carry
+    const uint32_t xsize = m_nSize; //size of this before growing
+    const uint32_t ysize = y.m_nSize; //in case y is *this
 
-    const uint32_t mask_msb = 1 << MSB; //mask for most significant bit
-    const uint32_t mask_lsb = ~mask_msb; //mask for the rest of the bits
+    grow(std::max(xsize, ysize)); //make enough space for result
+    const word_t* py = y.m_pData; //after grow() in case y is *this
 
-    uint32_t i; //looping variable
-    uint32_t oldsize = m_nSize;
+    const word_t carry = xsize >= ysize?
+      add(m_pData, m_pData, xsize, py, ysize):
+      add(m_pData, py, ysize, m_pData, xsize);
 
-    grow(m_nSize > y.m_nSize? m_nSize: y.m_nSize); //make enough space for result
+    if(carry){ //carry of 1 fell out, need more space for result
+      grow(m_nSize + 1); //need one more place for carry
+      m_pData[m_nSize - 1] = 1; //set most significant digit
+    } //if
+  } //if
 
-    for(i=0; i<m_nSize; i++){ //for each word in the result
-      //grab a word from each operand
-      left = i < oldsize? m_pData[i]: 0;
-      right = i < y.m_nSize? y.m_pData[i]: 0;
+  return *this;
+} //operator+=
 
-      //extract the most significant bit (msb) from each
-      left_msb  = (left  & mask_msb) >> MSB;
-      right_msb = (right & mask_msb) >> MSB;
+/// Add a 64-bit unsigned integer. This is done by add(), which stops as
+/// soon as there is nothing left to carry, and does not allocate any memory
+/// unless the sum needs more words.
+/// \param y Operand.
+/// \return Reference after addition.
 
-      //zero out the msb from each
-      left  &= mask_lsb;
-      right &= mask_lsb;
+uintx_t& uintx_t::operator+=(uint64_t y){
+  if(!m_bNaN && y > 0){
+    word_t w[WORDS_IN_UINT64]; //the words of y
+    const uint32_t n = split(y, w); //number of words in y
 
-      //add them
-      sum = left + right + carry;
+    grow(n); //this must be at least as long as y
+    const word_t carry = add(m_pData, m_pData, m_nSize, w, n);
 
-      //compute carry
-      sum_msb = (sum & mask_msb) >> (BITS_IN_WORD - 1);
-      sum &=  mask_lsb;
-      carry = left_msb + right_msb + sum_msb; //carry is either 0, 1, 2, or 3 here
+    if(carry){ //carry of 1 fell out, need more space for result
+      grow(m_nSize + 1);
+      m_pData[m_nSize - 1] = 1;
+    } //if
+  } //if
 
-      //put leading bit of carry back into sum
-      if((carry == 1) || (carry == 3))
-        sum |= mask_msb;
+  return *this;
+} //operator+=
 
-      m_pData[i] = sum;
+/// Add a 32-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param y Operand.
+/// \return Reference after addition.
 
-      //pass along leading bit of carry
-      carry >>= 1;
-    } //for
+uintx_t& uintx_t::operator+=(int32_t y){
+  return y < 0? *this = NaN: *this += uint64_t(y);
+} //operator+=
 
-    if(carry >= 1){ //carry of 1 fell out, need more space for result
-      grow(m_nSize + 1); //need one more place for carry
-      m_pData[m_nSize - 1] = 1; //set most significant digit
-    } //if
-  } //if
+/// Add a 64-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param y Operand.
+/// \return Reference after addition.
 
-  return *this;
+uintx_t& uintx_t::operator+=(int64_t y){
+  return y < 0? *this = NaN: *this += uint64_t(y);
+} //operator+=
+
+/// Add a 32-bit unsigned integer.
+/// \param y Operand.
+/// \return Reference after addition.
+
+uintx_t& uintx_t::operator+=(uint32_t y){
+  return *this += uint64_t(y);
 } //operator+=
 
+/// Add a 64-bit unsigned integer.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return The sum of the two operands.
+
+uintx_t operator+(const uintx_t& x, uint64_t y){
+  uintx_t result = x;
+  result += y;
+  return result;
+} //operator+
+
+/// Add a 32-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return The sum of the two operands.
+
+uintx_t operator+(const uintx_t& x, int32_t y){
+  return y < 0? uintx_t::NaN: x + uint64_t(y);
+} //operator+
+
+/// Add a 64-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return The sum of the two operands.
+
+uintx_t operator+(const uintx_t& x, int64_t y){
+  return y < 0? uintx_t::NaN: x + uint64_t(y);
+} //operator+
+
+/// Add a 32-bit unsigned integer.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return The sum of the two operands.
+
+uintx_t operator+(const uintx_t& x, uint32_t y){
+  return x + uint64_t(y);
+} //operator+
+
+/// Add a 32-bit integer. This is the same as with the operands
+/// the other way around.
+/// \param y First operand.
+/// \param x Second operand.
+/// \return The sum of the two operands.
+
+uintx_t operator+(int32_t y, const uintx_t& x){
+  return x + y;
+} //operator+
+
+/// Add a 64-bit integer. This is the same as with the operands
+/// the other way around.
+/// \param y First operand.
+/// \param x Second operand.
+/// \return The sum of the two operands.
+
+uintx_t operator+(int64_t y, const uintx_t& x){
+  return x + y;
+} //operator+
+
+/// Add a 32-bit unsigned integer. This is the same as with the operands
+/// the other way around.
+/// \param y First operand.
+/// \param x Second operand.
+/// \return The sum of the two operands.
+
+uintx_t operator+(uint32_t y, const uintx_t& x){
+  return x + y;
+} //operator+
+
+/// Add a 64-bit unsigned integer. This is the same as with the operands
+/// the other way around.
+/// \param y First operand.
+/// \param x Second operand.
+/// \return The sum of the two operands.
+
+uintx_t operator+(uint64_t y, const uintx_t& x){
+  return x + y;
+} //operator+
+
 #pragma endregion addition
 
 /////////////////////////////////////////////////////////////////////////////
@@ -381,12 +660,15 @@ uintx_t& uintx_t::operator+=(const uintx_t& y){
 /// \param y A extensible unsigned integer
 /// \return y subtracted from x, if non-negative.
 
-const uintx_t operator-(const uintx_t& x, const uintx_t& y){ 
+uintx_t operator-(const uintx_t& x, const uintx_t& y){ 
   uintx_t result(x);
-  return result -= y;
+  result -= y;
+  return result;
 } //operator-
 
-/// Subtract a extensible unsigned integer.
+/// Subtract a extensible unsigned integer. The words that both operands
+/// have are subtracted by sub(), which runs the borrow through the rest
+/// of this one until it dies out. The result is NaN if a borrow falls out.
 /// \param y A extensible unsigned integer.
 /// \return Reference to this extensible unsigned integer after y is subtracted.
 
@@ -395,34 +677,107 @@ uintx_t& uintx_t::operator-=(const uintx_t& y){
     m_bNaN = true;
 
   if(!m_bNaN){
-    if(y > *this)
-      m_bNaN = true; //subtracting something too big
+    const uint32_t n = std::min(m_nSize, y.m_nSize); //number of overlapping words
+    word_t borrow = sub(m_pData, m_pData, m_nSize, y.m_pData, n);
 
-    else if(y > 0U){
-      bool borrow = false; //single-bit borrow
+    for(uint32_t i=n; i<y.m_nSize; i++) //any more of y is too big
+      borrow |= y.m_pData[i] != 0;
 
-      for(uint32_t i=0; i<m_nSize; i++){ //for each word in the result
-        //grab a word from each operand
-        uint32_t left = m_pData[i];
-        uint32_t right = (i < y.m_nSize)? y.m_pData[i]: 0;
+    if(borrow) //subtracted something too big
+      *this = NaN;
 
-        //subtract them
-        if(borrow)
-          borrow = ++right == 0; //try to add borrow to right
+    else normalize();
+  } //if
 
-        m_pData[i] = left - right; //subtraction of uint32_t borrows automatically
+  return *this;
+} //operator-=
 
-        if(left < right)
-          borrow = true;
-      } //for
-    } //else
+/// Subtract a 64-bit unsigned integer. This is done by sub(), which stops
+/// as soon as there is nothing left to borrow, and does not allocate any
+/// memory unless the result is NaN.
+/// \param y Operand.
+/// \return Reference after subtraction.
 
-    normalize();
+uintx_t& uintx_t::operator-=(uint64_t y){
+  if(!m_bNaN && y > 0){
+    word_t w[WORDS_IN_UINT64]; //the words of y
+    const uint32_t n = split(y, w); //number of words in y
+
+    if(m_nSize < n || sub(m_pData, m_pData, m_nSize, w, n)) //subtracted something too big
+      *this = NaN;
+
+    else normalize();
   } //if
 
   return *this;
 } //operator-=
 
+/// Subtract a 32-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param y Operand.
+/// \return Reference after subtraction.
+
+uintx_t& uintx_t::operator-=(int32_t y){
+  return y < 0? *this = NaN: *this -= uint64_t(y);
+} //operator-=
+
+/// Subtract a 64-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param y Operand.
+/// \return Reference after subtraction.
+
+uintx_t& uintx_t::operator-=(int64_t y){
+  return y < 0? *this = NaN: *this -= uint64_t(y);
+} //operator-=
+
+/// Subtract a 32-bit unsigned integer.
+/// \param y Operand.
+/// \return Reference after subtraction.
+
+uintx_t& uintx_t::operator-=(uint32_t y){
+  return *this -= uint64_t(y);
+} //operator-=
+
+/// Subtract a 64-bit unsigned integer.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return y subtracted from x, if non-negative.
+
+uintx_t operator-(const uintx_t& x, uint64_t y){
+  uintx_t result(x);
+  result -= y;
+  return result;
+} //operator-
+
+/// Subtract a 32-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return y subtracted from x, if non-negative.
+
+uintx_t operator-(const uintx_t& x, int32_t y){
+  return y < 0? uintx_t::NaN: x - uint64_t(y);
+} //operator-
+
+/// Subtract a 64-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return y subtracted from x, if non-negative.
+
+uintx_t operator-(const uintx_t& x, int64_t y){
+  return y < 0? uintx_t::NaN: x - uint64_t(y);
+} //operator-
+
+/// Subtract a 32-bit unsigned integer.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return y subtracted from x, if non-negative.
+
+uintx_t operator-(const uintx_t& x, uint32_t y){
+  return x - uint64_t(y);
+} //operator-
+
 #pragma endregion subtraction
 
 /////////////////////////////////////////////////////////////////////////////
@@ -471,24 +826,82 @@ uintx_t uintx_t::operator--(int){
 
 #pragma region comparison
 
-/// Greater than test. Assumes that both operands are normalized.
+/// Three-way comparison in a single pass from the most significant end.
+/// Assumes that both operands are normalized. NaN compares less than
+/// every number and equal to NaN.
 /// \param x First operand.
 /// \param y Second operand.
-/// \return true If the first operand is greater than the second.
+/// \return Negative, zero, or positive as the first operand is less than,
+/// equal to, or greater than the second.
 
-const bool operator>(const uintx_t& x, const uintx_t& y){ 
-  if(x.m_bNaN)return false;
-  if(y.m_bNaN)return true;
+const int32_t compare(const uintx_t& x, const uintx_t& y){
+  if(x.m_bNaN || y.m_bNaN)
+    return int32_t(y.m_bNaN) - int32_t(x.m_bNaN);
 
-  if(x.m_nSize > y.m_nSize)return true; 
-  if(x.m_nSize < y.m_nSize)return false; 
+  if(x.m_nSize != y.m_nSize)
+    return x.m_nSize > y.m_nSize? 1: -1; 
 
-  //check m_pData
-  for(int32_t i=x.m_nSize-1; i>=0; i--)
-    if(x.m_pData[i] > y.m_pData[i])return true; 
-    else if(x.m_pData[i] < y.m_pData[i])return false; 
+  return cmp(x.m_pData, y.m_pData, x.m_nSize);
+} //compare
+
+/// Three-way comparison with a 64-bit unsigned integer, without converting
+/// it to an extensible unsigned integer. Assumes that the first operand is
+/// normalized.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return Negative, zero, or positive as the first operand is less than,
+/// equal to, or greater than the second.
+
+const int32_t compare(const uintx_t& x, uint64_t y){
+  if(x.m_bNaN)return -1;
+  if(x.m_nSize > WORDS_IN_UINT64)return 1;
+
+  const uint64_t v = to_uint64(x); //value of x
+
+  return v == y? 0: v > y? 1: -1;
+} //compare
+
+/// Three-way comparison with a 64-bit integer. A negative integer compares
+/// less than every number and equal to NaN, as if it had been converted to
+/// an extensible unsigned integer.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return Negative, zero, or positive as the first operand is less than,
+/// equal to, or greater than the second.
+
+const int32_t compare(const uintx_t& x, int64_t y){
+  if(y < 0)return x.m_bNaN? 0: 1;
+  return compare(x, uint64_t(y));
+} //compare
+
+/// Three-way comparison with a 32-bit integer. See compare(const uintx_t&,
+/// int64_t).
+/// \param x First operand.
+/// \param y Second operand.
+/// \return Negative, zero, or positive as the first operand is less than,
+/// equal to, or greater than the second.
+
+const int32_t compare(const uintx_t& x, int32_t y){
+  return compare(x, int64_t(y));
+} //compare
+
+/// Three-way comparison with a 32-bit unsigned integer.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return Negative, zero, or positive as the first operand is less than,
+/// equal to, or greater than the second.
+
+const int32_t compare(const uintx_t& x, uint32_t y){
+  return compare(x, uint64_t(y));
+} //compare
+
+/// Greater than test.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is greater than the second.
 
-  return false; //they're equal
+const bool operator>(const uintx_t& x, const uintx_t& y){ 
+  return compare(x, y) > 0;
 } //operator>
 
 /// Greater than or equal to test.
@@ -497,17 +910,7 @@ const bool operator>(const uintx_t& x, const uintx_t& y){
 /// \return true If the first operand is greater than or equal to the second.
 
 const bool operator>=(const uintx_t& x, const uintx_t& y){ 
-  if(y.m_bNaN)return true;
-  if(x.m_bNaN)return false;
-  if(x.m_nSize > y.m_nSize)return true; 
-  if(x.m_nSize < y.m_nSize)return false; 
-
-  //check m_pData
-  for(int32_t i=x.m_nSize-1; i>=0; i--)
-    if(x.m_pData[i] >y .m_pData[i])return true; //x>y
-    else if(x.m_pData[i] < y.m_pData[i])return false; //x<y
-
-  return true; //they're equal
+  return compare(x, y) >= 0;
 } //operator>=
 
 /// Less than test.
@@ -516,7 +919,7 @@ const bool operator>=(const uintx_t& x, const uintx_t& y){
 /// \return true If the first operand is less than the second.
 
 const bool operator<(const uintx_t& x, const uintx_t& y){ 
-  return y > x;
+  return compare(x, y) < 0;
 } //operator<
 
 /// Less than or equal to test.
@@ -525,7 +928,7 @@ const bool operator<(const uintx_t& x, const uintx_t& y){
 /// \return true If the first operand is less than or equal to the second.
 
 const bool operator<=(const uintx_t& x, const uintx_t& y){ 
-  return y >= x;
+  return compare(x, y) <= 0;
 } //operator<=
 
 /// Equality test.
@@ -563,67 +966,303 @@ const bool operator!=(const uintx_t& x, const uintx_t& y){
   return !(x == y); 
 } //operator!=
 
-#pragma endregion comparison
-
-/////////////////////////////////////////////////////////////////////////////
-// Bit shift operators.
+/// Greater than test against a 32-bit integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is greater than the second.
 
-#pragma region shift
+const bool operator>(const uintx_t& x, int32_t y){ 
+  return compare(x, y) > 0;
+} //operator>
 
-/// Left-shift operator.
-/// \param n Shift distance in bits.
-/// \return Reference after left-shifting.
+/// Greater than test against a 64-bit integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is greater than the second.
 
-uintx_t& uintx_t::operator<<=(int32_t n){ 
-  if(n < 0)
-    return *this >>= -n;
+const bool operator>(const uintx_t& x, int64_t y){ 
+  return compare(x, y) > 0;
+} //operator>
 
-  if(n == 0)
-    return *this;
+/// Greater than test against a 32-bit unsigned integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is greater than the second.
 
-  if(*this > 0 && !m_bNaN){
-    int32_t oldsize = m_nSize; //save old m_nSize for later
+const bool operator>(const uintx_t& x, uint32_t y){ 
+  return compare(x, y) > 0;
+} //operator>
 
-    //compute new number of bits - divide by BitsPerWord and round up
-    grow((log2x(*this) + n + BITS_IN_WORD)/BITS_IN_WORD);
+/// Greater than test against a 64-bit unsigned integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is greater than the second.
 
-    //shift by word
-    int32_t dest = m_nSize - 1; //copy destination
-    int32_t src = dest - n/BITS_IN_WORD; //copy source
+const bool operator>(const uintx_t& x, uint64_t y){ 
+  return compare(x, y) > 0;
+} //operator>
 
-    while(src >= 0){ //until end of source
-      if(src < oldsize)
-        m_pData[dest] = m_pData[src]; //copy
-        dest--; src--; //move along
-    } //while
+/// Greater than or equal to test against a 32-bit integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is greater than or equal to the second.
+
+const bool operator>=(const uintx_t& x, int32_t y){ 
+  return compare(x, y) >= 0;
+} //operator>=
+
+/// Greater than or equal to test against a 64-bit integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is greater than or equal to the second.
+
+const bool operator>=(const uintx_t& x, int64_t y){ 
+  return compare(x, y) >= 0;
+} //operator>=
+
+/// Greater than or equal to test against a 32-bit unsigned integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is greater than or equal to the second.
+
+const bool operator>=(const uintx_t& x, uint32_t y){ 
+  return compare(x, y) >= 0;
+} //operator>=
+
+/// Greater than or equal to test against a 64-bit unsigned integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is greater than or equal to the second.
+
+const bool operator>=(const uintx_t& x, uint64_t y){ 
+  return compare(x, y) >= 0;
+} //operator>=
+
+/// Less than test against a 32-bit integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is less than the second.
+
+const bool operator<(const uintx_t& x, int32_t y){ 
+  return compare(x, y) < 0;
+} //operator<
+
+/// Less than test against a 64-bit integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is less than the second.
+
+const bool operator<(const uintx_t& x, int64_t y){ 
+  return compare(x, y) < 0;
+} //operator<
+
+/// Less than test against a 32-bit unsigned integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is less than the second.
+
+const bool operator<(const uintx_t& x, uint32_t y){ 
+  return compare(x, y) < 0;
+} //operator<
+
+/// Less than test against a 64-bit unsigned integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is less than the second.
+
+const bool operator<(const uintx_t& x, uint64_t y){ 
+  return compare(x, y) < 0;
+} //operator<
+
+/// Less than or equal to test against a 32-bit integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is less than or equal to the second.
+
+const bool operator<=(const uintx_t& x, int32_t y){ 
+  return compare(x, y) <= 0;
+} //operator<=
+
+/// Less than or equal to test against a 64-bit integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is less than or equal to the second.
+
+const bool operator<=(const uintx_t& x, int64_t y){ 
+  return compare(x, y) <= 0;
+} //operator<=
+
+/// Less than or equal to test against a 32-bit unsigned integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is less than or equal to the second.
+
+const bool operator<=(const uintx_t& x, uint32_t y){ 
+  return compare(x, y) <= 0;
+} //operator<=
+
+/// Less than or equal to test against a 64-bit unsigned integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is less than or equal to the second.
+
+const bool operator<=(const uintx_t& x, uint64_t y){ 
+  return compare(x, y) <= 0;
+} //operator<=
+
+/// Equality test against a 32-bit integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is equal to the second.
+
+const bool operator==(const uintx_t& x, int32_t y){ 
+  return compare(x, y) == 0;
+} //operator==
+
+/// Equality test against a 64-bit integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is equal to the second.
+
+const bool operator==(const uintx_t& x, int64_t y){ 
+  return compare(x, y) == 0;
+} //operator==
+
+/// Equality test against a 32-bit unsigned integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is equal to the second.
+
+const bool operator==(const uintx_t& x, uint32_t y){ 
+  return compare(x, y) == 0;
+} //operator==
+
+/// Equality test against a 64-bit unsigned integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is equal to the second.
+
+const bool operator==(const uintx_t& x, uint64_t y){ 
+  return compare(x, y) == 0;
+} //operator==
+
+/// Inequality test against a 32-bit integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is not equal to the second.
+
+const bool operator!=(const uintx_t& x, int32_t y){ 
+  return compare(x, y) != 0;
+} //operator!=
+
+/// Inequality test against a 64-bit integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is not equal to the second.
+
+const bool operator!=(const uintx_t& x, int64_t y){ 
+  return compare(x, y) != 0;
+} //operator!=
+
+/// Inequality test against a 32-bit unsigned integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is not equal to the second.
+
+const bool operator!=(const uintx_t& x, uint32_t y){ 
+  return compare(x, y) != 0;
+} //operator!=
+
+/// Inequality test against a 64-bit unsigned integer, which does not allocate any memory.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return true If the first operand is not equal to the second.
+
+const bool operator!=(const uintx_t& x, uint64_t y){ 
+  return compare(x, y) != 0;
+} //operator!=
+
+#pragma endregion comparison
+
+/////////////////////////////////////////////////////////////////////////////
+// Bit shift operators.
 
-    while(dest >= 0)
-      m_pData[dest--] = 0; //fill bottom with zeros
+#pragma region shift
 
-    //shift within words
+/// Left-shift operator. The number of words in the result is known before
+/// shifting from the bits that will be shifted out of the top word, so the
+/// value grows just once, reusing the spare capacity if there is enough,
+/// and there are no leading zero words to remove. The words are moved up
+/// and shifted within words in a single pass by lshift(), then the bottom
+/// words are zeroed.
+/// \param n Shift distance in bits.
+/// \return Reference after left-shifting.
+
+uintx_t& uintx_t::operator<<=(int32_t n){ 
+  if(n < 0)
+    return *this >>= -n;
+
+  if(n > 0 && !is_zero() && !m_bNaN){
+    const uint32_t oldsize = m_nSize; //save old m_nSize for later
+    const uint32_t words = n/BITS_IN_WORD; //shift distance in words
     const uint32_t d = n%BITS_IN_WORD; //shift distance within words
+    const word_t top = d > 0? m_pData[oldsize - 1] >> (BITS_IN_WORD - d): 0; //shifted out
 
-    if(d > 0)
-      for(dest=m_nSize - 1; dest>=0; --dest){
-        m_pData[dest] <<= d;
-        if(dest > 0)
-          m_pData[dest] |= (m_pData[dest - 1] >> (BITS_IN_WORD - d));
-      } //for
+    grow(oldsize + words + (top > 0? 1: 0));
+    lshift(m_pData + words, m_pData, oldsize, d);
+    std::fill(m_pData, m_pData + words, 0); //fill bottom with zeros
+    if(top > 0)m_pData[m_nSize - 1] = top;
   } //if
 
   return *this;
 } //operator<<=
 
+/// Left-shift into a destination without changing the operand. This is
+/// done the same way as operator<<=(), except that the words are shifted
+/// from the operand straight into the destination instead of being copied
+/// first. The destination reuses its own storage if it has the capacity,
+/// so shifting into the same destination repeatedly, for example inside a
+/// loop, does not allocate memory.
+/// \param x Operand.
+/// \param n Shift distance in bits.
+/// \param r [out] The operand left-shifted by n bits. May be the operand.
+
+void lshiftx(const uintx_t& x, int32_t n, uintx_t& r){
+  if(&r == &x)
+    r <<= n;
+
+  else if(n < 0)
+    rshiftx(x, -n, r);
+
+  else if(x.m_bNaN || x.is_zero())
+    r = x;
+
+  else{
+    const uint32_t words = n/BITS_IN_WORD; //shift distance in words
+    const uint32_t d = n%BITS_IN_WORD; //shift distance within words
+    const word_t top = d > 0? x.m_pData[x.m_nSize - 1] >> (BITS_IN_WORD - d): 0; //shifted out
+
+    r.resize(x.m_nSize + words + (top > 0? 1: 0));
+    lshift(r.m_pData + words, x.m_pData, x.m_nSize, d);
+    std::fill(r.m_pData, r.m_pData + words, 0); //fill bottom with zeros
+    if(top > 0)r.m_pData[r.m_nSize - 1] = top;
+  } //else
+} //lshiftx
+
 /// Left-shift operator.
 /// \param x First operand.
 /// \param d Second operand.
 /// \return The first operand left-shifted by the second operand.
 
-const uintx_t operator<<(const uintx_t& x, int32_t d){ 
-  return uintx_t(x) <<= d;
+uintx_t operator<<(const uintx_t& x, int32_t d){ 
+  uintx_t result;
+  lshiftx(x, d, result);
+  return result;
 } //operator<<
 
-/// Right-shift operator.
+/// Right-shift operator. The words are moved down and shifted within words
+/// in a single pass by rshift(). Only the top word can become zero, and
+/// the space is kept for later growth.
 /// \param n Number of bits to right-shift by.
 /// \return Reference after right-shifting.
 
@@ -631,52 +1270,67 @@ uintx_t& uintx_t::operator>>=(const int32_t n){
   if(n < 0)
     return *this >>= -n;
 
-  if(!m_bNaN){
-    //uint32_t newsize = (this->bitsize() - n + BITS_IN_WORD - 1)/BITS_IN_WORD;
-    uint32_t newsize = m_nSize - n/BITS_IN_WORD;
+  if(n > 0 && !m_bNaN){
+    const uint32_t words = n/BITS_IN_WORD; //shift distance in words
 
-    if(newsize <= 0)
-      *this = 0;
+    if(words >= m_nSize){ //everything is shifted out
+      m_pData[0] = 0;
+      m_nSize = 1;
+    } //if
 
     else{
-      //first shift by word
-      uint32_t dest = 0; //copy destination
-      uint32_t src = dest + n/BITS_IN_WORD; //copy source
-
-      if(dest != src)
-        while(src < m_nSize){ //until end of source
-          m_pData[dest] = m_pData[src]; //copy
-          m_pData[src] = 0; //zero out copied word
-          dest++; src++; //move along
-        } //while
-
-      //then shift within words
-      const uint32_t d = n%BITS_IN_WORD; //shift distance within words
-
-      if(d > 0)
-        for(dest=0; dest<newsize; dest++){
-          m_pData[dest] >>= d;
-          if(dest < m_nSize - 1)
-            m_pData[dest] |= (m_pData[dest + 1] << (BITS_IN_WORD - d));
-        } //for
+      m_nSize -= words;
+      rshift(m_pData, m_pData + words, m_nSize, n%BITS_IN_WORD);
+      normalize(); //remove leading zero word
     } //else
-
-    for(uint32_t i=newsize; i<m_nSize; i++)
-      m_pData[i] = 0; //zero out unused portion
-
-    normalize(); //remove leading zero words
   } //if
 
   return *this;
 } //operator>>=
 
+/// Right-shift into a destination without changing the operand. This is
+/// done the same way as operator>>=(), shifting the words from the operand
+/// straight into the destination, which reuses its own storage if it has
+/// the capacity.
+/// \param x Operand.
+/// \param n Shift distance in bits.
+/// \param r [out] The operand right-shifted by n bits. May be the operand.
+
+void rshiftx(const uintx_t& x, int32_t n, uintx_t& r){
+  if(&r == &x)
+    r >>= n;
+
+  else if(n < 0)
+    rshiftx(x, -n, r);
+
+  else if(x.m_bNaN)
+    r = x;
+
+  else{
+    const uint32_t words = n/BITS_IN_WORD; //shift distance in words
+
+    if(words >= x.m_nSize){ //everything is shifted out
+      r.resize(1);
+      r.m_pData[0] = 0;
+    } //if
+
+    else{
+      r.resize(x.m_nSize - words);
+      rshift(r.m_pData, x.m_pData + words, r.m_nSize, n%BITS_IN_WORD);
+      r.normalize(); //remove leading zero word
+    } //else
+  } //else
+} //rshiftx
+
 /// Right-shift operator.
 /// \param x First operand.
 /// \param d Second operand.
-/// \return The first operand left-shifted by the second operand.
+/// \return The first operand right-shifted by the second operand.
 
-const uintx_t operator>>(const uintx_t& x, int32_t d){ 
-  return uintx_t(x) >>= d;
+uintx_t operator>>(const uintx_t& x, int32_t d){ 
+  uintx_t result;
+  rshiftx(x, d, result);
+  return result;
 } //operator>>
 
 #pragma endregion shift
@@ -686,7 +1340,9 @@ const uintx_t operator>>(const uintx_t& x, int32_t d){
 
 #pragma region bitwise
 
-/// Bitwise conjunction operator.
+/// Bitwise conjunction operator. Only the words that both operands have
+/// can be non-zero in the result, so they are ANDed by and_n() and the
+/// rest are dropped.
 /// \param y Operand.
 /// \return Reference after ANDing with operand.
 
@@ -695,15 +1351,11 @@ uintx_t& uintx_t::operator&=(const uintx_t& y){
     m_bNaN = true;
 
   if(!m_bNaN){
-    //const uint32_t n = std::min(m_nSize, y.m_nSize);
-    //grow(n);
-
-    for(uint32_t i=0; i<m_nSize; i++)
-      m_pData[i] &= y.m_pData[i];
+    m_nSize = std::min(m_nSize, y.m_nSize);
+    and_n(m_pData, m_pData, y.m_pData, m_nSize);
+    normalize();
   } //if
 
-  normalize();
-
   return *this;
 } //operator&=
 
@@ -712,11 +1364,14 @@ uintx_t& uintx_t::operator&=(const uintx_t& y){
 /// \param y Second operand.
 /// \return The first operand ANDed with the second.
 
-const uintx_t operator&(const uintx_t& x, const uintx_t& y){
-  return uintx_t(x) &= y;
+uintx_t operator&(const uintx_t& x, const uintx_t& y){
+  uintx_t result(x);
+  result &= y;
+  return result;
 } //operator&
 
-/// Bitwise disjunction operator.
+/// Bitwise disjunction operator. The words that both operands have are
+/// ORed by ior_n(), and the rest of the longer one is copied.
 /// \param y Operand.
 /// \return Reference after ORing with operand.
 
@@ -725,11 +1380,16 @@ uintx_t& uintx_t::operator|=(const uintx_t& y){
     m_bNaN = true;
 
   if(!m_bNaN){
-    const uint32_t n = std::min(m_nSize, y.m_nSize);
-    grow(n);
+    const uint32_t xsize = m_nSize; //size of this before growing
+    const uint32_t ysize = y.m_nSize; //in case y is *this
 
-    for(uint32_t i=0; i<n; i++)
-      m_pData[i] |= y.m_pData[i];
+    grow(ysize); //make enough space for result
+    const word_t* py = y.m_pData; //after grow() in case y is *this
+
+    ior_n(m_pData, m_pData, py, std::min(xsize, ysize));
+
+    if(ysize > xsize)
+      std::copy(py + xsize, py + ysize, m_pData + xsize);
   } //if
 
   return *this;
@@ -740,11 +1400,14 @@ uintx_t& uintx_t::operator|=(const uintx_t& y){
 /// \param y Second operand.
 /// \return The first operand ORed with the second.
 
-const uintx_t operator|(const uintx_t& x, const uintx_t& y){
-  return uintx_t(x) |= y;
+uintx_t operator|(const uintx_t& x, const uintx_t& y){
+  uintx_t result(x);
+  result |= y;
+  return result;
 } //operator|
 
-/// Bitwise exclusive-or operator.
+/// Bitwise exclusive-or operator. The words that both operands have are
+/// XORed by xor_n(), and the rest of the longer one is copied.
 /// \param y Operand.
 /// \return Reference after XORing with operand.
 
@@ -753,14 +1416,19 @@ uintx_t& uintx_t::operator^=(const uintx_t& y){
     m_bNaN = true;
 
   if(!m_bNaN){
-    const uint32_t n = std::min(m_nSize, y.m_nSize);
-    grow(n);
+    const uint32_t xsize = m_nSize; //size of this before growing
+    const uint32_t ysize = y.m_nSize; //in case y is *this
 
-    for(uint32_t i=0; i<n; i++)
-      m_pData[i] ^= y.m_pData[i];
-  } //if
+    grow(ysize); //make enough space for result
+    const word_t* py = y.m_pData; //after grow() in case y is *this
+
+    xor_n(m_pData, m_pData, py, std::min(xsize, ysize));
 
-  normalize();
+    if(ysize > xsize)
+      std::copy(py + xsize, py + ysize, m_pData + xsize);
+
+    normalize();
+  } //if
 
   return *this;
 } //operator^=
@@ -770,22 +1438,33 @@ uintx_t& uintx_t::operator^=(const uintx_t& y){
 /// \param y Second operand.
 /// \return The first operand XORed with the second.
 
-const uintx_t operator^(const uintx_t& x, const uintx_t& y){
-  return uintx_t(x) ^= y;
+uintx_t operator^(const uintx_t& x, const uintx_t& y){
+  uintx_t result(x);
+  result ^= y;
+  return result;
 } //operator^
 
-/// Bitwise negation.
+/// Bitwise negation of the words of the operand by com(). The bits are
+/// flipped up to the top of the most significant 32-bit half-word that the
+/// operand uses, so that the result is the same for 64-bit words as for
+/// 32-bit words.
 /// \param x Operand.
 /// \return The operand with all bits flipped.
 
-const uintx_t operator~(const uintx_t& x){
+uintx_t operator~(const uintx_t& x){
   uintx_t result(x);
 
-  if(!result.m_bNaN)
-    for(uint32_t i=0; i<x.m_nSize; i++)
-      result.m_pData[i] = ~result.m_pData[i];
+  if(!result.m_bNaN){
+    const uint32_t n = result.m_nSize; //number of words
+    const word_t top = x.m_pData[n - 1]; //most significant word
+
+    com(result.m_pData, result.m_pData, n);
 
-  result.normalize();
+    if((top & LOW_32_BITS) == top) //top half of a 64-bit word is unused
+      result.m_pData[n - 1] &= LOW_32_BITS;
+
+    result.normalize();
+  } //if
 
   return result;
 } //operator~
@@ -797,64 +1476,179 @@ const uintx_t operator~(const uintx_t& x){
 
 #pragma region multiplication
 
-/// Multiplication operator.
+/// Multiplication operator. The product is computed directly into a
+/// single result buffer that is allocated once at full size. See mul()
+/// for the choice of algorithm. If both operands are the same object,
+/// as in `x*x` or `x *= x`, then the faster squaring algorithm sqr() is
+/// used instead.
 /// \param y First operand.
 /// \param z Second operand.
 /// \return The first operand multiplied by the second.
 
-const uintx_t operator*(const uintx_t& y, const uintx_t& z){ 
+uintx_t operator*(const uintx_t& y, const uintx_t& z){ 
   if(y.m_bNaN || z.m_bNaN)
     return uintx_t::NaN;
 
-  uintx_t result(0); //return result
+  uintx_t result; //return result
+  result.reallocate(y.m_nSize + z.m_nSize); //enough space for the product
+
+  if(&y == &z)
+    sqr(result.m_pData, y.m_pData, y.m_nSize);
+  else mul(result.m_pData, y.m_pData, y.m_nSize, z.m_pData, z.m_nSize);
+
+  result.normalize(); //remove leading zero words
 
-  if(y.m_nSize == 1 && z.m_nSize == 1)
-    result = to_uint64(y)*to_uint64(z);
+  return result;
+} //operator*
 
-  else if(z.m_nSize == 1)
-    result = z*y;
+/// Multiplication operator.
+/// \param y Operand.
+/// \return Reference after multiplication by the second.
 
-  else if(y.m_nSize == 1){  //special case, y is a single word and z is not
-    uintx_t word, carry(0);
-    const uint64_t y64 = to_uint64(y);
+uintx_t& uintx_t::operator*=(const uintx_t& y){ 
+  return *this = (*this)*y;
+} //operator*=
 
-    word.grow(z.m_nSize);
-    carry.grow(z.m_nSize + 1);
+/// Multiply by a 64-bit unsigned integer. A multiplier that fits into a
+/// single word takes a single pass in place with mul_1(), which does not
+/// allocate any memory unless the product needs another word.
+/// \param y Operand.
+/// \return Reference after multiplication.
 
-    for(uint32_t i=0; i<z.m_nSize; i++){
-      const uint64_t product = (uint64_t)z.m_pData[i]*y64;
-      carry.m_pData[i + 1] = uint32_t(product >> 32);
-      word.m_pData[i] = uint32_t(product & 0xFFFFFFFF);
-    } //for
+uintx_t& uintx_t::operator*=(uint64_t y){
+  if(!m_bNaN){
+    if(y <= WORD_MAX){ //single-word multiplier
+      const word_t carry = mul_1(m_pData, m_pData, m_nSize, word_t(y));
+
+      if(carry > 0){ //need one more place for carry
+        grow(m_nSize + 1);
+        m_pData[m_nSize - 1] = carry;
+      } //if
+
+      else if(y == 0)
+        normalize();
+    } //if
 
-    word.normalize();
-    carry.normalize();
+    else{ //two 32-bit words
+      const word_t w[2] = {word_t(y), word_t(y >> 32)};
+      uintx_t product;
+      product.reallocate(m_nSize + 2); //enough space for the product
+      mul(product.m_pData, m_pData, m_nSize, w, 2);
 
-    result = word + carry;
+      product.normalize(); //remove leading zero words
+      *this = std::move(product);
+    } //else
   } //if
 
-  else{ //general case, both operands have 2 or more words
-    uintx_t y0(y), z0(z); //local copies
+  return *this;
+} //operator*=
 
-    while(z0 > 0){
-      result += uintx_t(y0*z0.m_pData[0]);
+/// Multiply by a 32-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param y Operand.
+/// \return Reference after multiplication.
 
-      y0 <<= BITS_IN_WORD;
-      z0 >>= BITS_IN_WORD;
-    } //while
-  } //else
+uintx_t& uintx_t::operator*=(int32_t y){
+  return y < 0? *this = NaN: *this *= uint64_t(y);
+} //operator*=
 
-  return result;
-} //operator*
+/// Multiply by a 64-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param y Operand.
+/// \return Reference after multiplication.
 
-/// Multiplication operator.
+uintx_t& uintx_t::operator*=(int64_t y){
+  return y < 0? *this = NaN: *this *= uint64_t(y);
+} //operator*=
+
+/// Multiply by a 32-bit unsigned integer.
 /// \param y Operand.
-/// \return Reference after multiplication by the second.
+/// \return Reference after multiplication.
 
-uintx_t& uintx_t::operator*=(const uintx_t& y){ 
-  return *this = (*this)*y;
+uintx_t& uintx_t::operator*=(uint32_t y){
+  return *this *= uint64_t(y);
 } //operator*=
 
+/// Multiply by a 64-bit unsigned integer.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return The first operand multiplied by the second.
+
+uintx_t operator*(const uintx_t& x, uint64_t y){
+  uintx_t result(x);
+  result *= y;
+  return result;
+} //operator*
+
+/// Multiply by a 32-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return The first operand multiplied by the second.
+
+uintx_t operator*(const uintx_t& x, int32_t y){
+  return y < 0? uintx_t::NaN: x * uint64_t(y);
+} //operator*
+
+/// Multiply by a 64-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return The first operand multiplied by the second.
+
+uintx_t operator*(const uintx_t& x, int64_t y){
+  return y < 0? uintx_t::NaN: x * uint64_t(y);
+} //operator*
+
+/// Multiply by a 32-bit unsigned integer.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return The first operand multiplied by the second.
+
+uintx_t operator*(const uintx_t& x, uint32_t y){
+  return x * uint64_t(y);
+} //operator*
+
+/// Multiply by a 32-bit integer. This is the same as with the operands
+/// the other way around.
+/// \param y First operand.
+/// \param x Second operand.
+/// \return The first operand multiplied by the second.
+
+uintx_t operator*(int32_t y, const uintx_t& x){
+  return x * y;
+} //operator*
+
+/// Multiply by a 64-bit integer. This is the same as with the operands
+/// the other way around.
+/// \param y First operand.
+/// \param x Second operand.
+/// \return The first operand multiplied by the second.
+
+uintx_t operator*(int64_t y, const uintx_t& x){
+  return x * y;
+} //operator*
+
+/// Multiply by a 32-bit unsigned integer. This is the same as with the operands
+/// the other way around.
+/// \param y First operand.
+/// \param x Second operand.
+/// \return The first operand multiplied by the second.
+
+uintx_t operator*(uint32_t y, const uintx_t& x){
+  return x * y;
+} //operator*
+
+/// Multiply by a 64-bit unsigned integer. This is the same as with the operands
+/// the other way around.
+/// \param y First operand.
+/// \param x Second operand.
+/// \return The first operand multiplied by the second.
+
+uintx_t operator*(uint64_t y, const uintx_t& x){
+  return x * y;
+} //operator*
+
 #pragma endregion multiplication
 
 /////////////////////////////////////////////////////////////////////////////
@@ -862,34 +1656,22 @@ uintx_t& uintx_t::operator*=(const uintx_t& y){
 
 #pragma region division
 
-/// Division operator, rounding down to floor of the fraction.
+/// Division operator, rounding down to floor of the fraction. The quotient
+/// is computed a word at a time by divrem().
 /// \param y Numerator.
 /// \param z Denominator.
 /// \return Floor of the numerator divided by the denominator.
 
-const uintx_t operator/(const uintx_t& y, const uintx_t& z){
-  if(y.m_bNaN || z.m_bNaN || z == 0)
+uintx_t operator/(const uintx_t& y, const uintx_t& z){
+  if(y.m_bNaN || z.m_bNaN || z.is_zero())
     return uintx_t::NaN;
 
   uintx_t q(0); //result
 
   if(y >= z){
-    uintx_t r(y), w(z);
-
-    w <<= log2x(y) - log2x(z);
-
-    while(w <= y)
-      w <<= 1;
-
-    while(w > z){
-      q <<= 1; 
-      w >>= 1;
-
-      if(w <= r){
-        r -= w;
-        ++q;
-      } //if
-    } //while
+    q.reallocate(y.m_nSize - z.m_nSize + 1); //enough space for the quotient
+    divrem(q.m_pData, nullptr, y.m_pData, y.m_nSize, z.m_pData, z.m_nSize);
+    q.normalize(); //remove leading zero words
   } //if
 
   return q;
@@ -903,27 +1685,23 @@ uintx_t& uintx_t::operator/=(const uintx_t& y){
   return *this = *this/y;
 } //operator/
 
-/// Remainder operator.
+/// Remainder operator. The remainder is computed a word at a time by
+/// divrem().
 /// \param y Numerator.
 /// \param z Denominator.
 /// \return Remainder after the numerator is divided by the denominator.
 
-const uintx_t operator%(const uintx_t& y, const uintx_t& z){ 
-  if(y.m_bNaN || z.m_bNaN || z == 0)
+uintx_t operator%(const uintx_t& y, const uintx_t& z){ 
+  if(y.m_bNaN || z.m_bNaN || z.is_zero())
     return uintx_t::NaN;
 
-  uintx_t result(y); 
-  uintx_t w(z);
+  if(y < z)
+    return y;
 
-  while(w <= y)
-    w <<= 1;
-
-  while(w > z){ 
-    w >>= 1;
-
-    if(w <= result)
-      result -= w;
-  } //while
+  uintx_t result; //return result
+  result.reallocate(z.m_nSize); //enough space for the remainder
+  divrem(nullptr, result.m_pData, y.m_pData, y.m_nSize, z.m_pData, z.m_nSize);
+  result.normalize(); //remove leading zero words
 
   return result;
 } //operator%
@@ -936,8 +1714,309 @@ uintx_t& uintx_t::operator%=(const uintx_t& y){
   return *this = *this%y;
 } //operator%=
 
+/// Divide by a 64-bit unsigned integer, rounding down. A divisor that fits
+/// into a single word takes a single pass in place with divrem_1(), which
+/// does not allocate any memory unless the quotient is shorter.
+/// \param y Denominator.
+/// \return Reference after division by the denominator.
+
+uintx_t& uintx_t::operator/=(uint64_t y){
+  if(m_bNaN || y == 0)
+    return *this = NaN;
+
+  if(y <= WORD_MAX) //single-word divisor
+    divrem_1(m_pData, m_pData, m_nSize, word_t(y));
+
+  else if(m_nSize <= 2){ //quotient fits into a word
+    m_pData[0] = word_t(to_uint64(*this)/y);
+    if(m_nSize > 1)m_pData[1] = 0;
+  } //else if
+
+  else{ //two 32-bit words
+    const word_t w[2] = {word_t(y), word_t(y >> 32)};
+    uintx_t quotient;
+    quotient.reallocate(m_nSize - 1); //enough space for the quotient
+    divrem(quotient.m_pData, nullptr, m_pData, m_nSize, w, 2);
+    *this = std::move(quotient);
+  } //else
+
+  normalize(); //remove leading zero words
+  return *this;
+} //operator/=
+
+/// Divide by a 32-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param y Operand.
+/// \return Reference after division by the denominator.
+
+uintx_t& uintx_t::operator/=(int32_t y){
+  return y < 0? *this = NaN: *this /= uint64_t(y);
+} //operator/=
+
+/// Divide by a 64-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param y Operand.
+/// \return Reference after division by the denominator.
+
+uintx_t& uintx_t::operator/=(int64_t y){
+  return y < 0? *this = NaN: *this /= uint64_t(y);
+} //operator/=
+
+/// Divide by a 32-bit unsigned integer.
+/// \param y Operand.
+/// \return Reference after division by the denominator.
+
+uintx_t& uintx_t::operator/=(uint32_t y){
+  return *this /= uint64_t(y);
+} //operator/=
+
+/// Divide by a 64-bit unsigned integer, rounding down.
+/// \param x Numerator.
+/// \param y Denominator.
+/// \return Floor of the numerator divided by the denominator.
+
+uintx_t operator/(const uintx_t& x, uint64_t y){
+  uintx_t result(x);
+  result /= y;
+  return result;
+} //operator/
+
+/// Divide by a 32-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param x Numerator.
+/// \param y Denominator.
+/// \return Floor of the numerator divided by the denominator.
+
+uintx_t operator/(const uintx_t& x, int32_t y){
+  return y < 0? uintx_t::NaN: x / uint64_t(y);
+} //operator/
+
+/// Divide by a 64-bit integer. The result is NaN if the operand is
+/// negative.
+/// \param x Numerator.
+/// \param y Denominator.
+/// \return Floor of the numerator divided by the denominator.
+
+uintx_t operator/(const uintx_t& x, int64_t y){
+  return y < 0? uintx_t::NaN: x / uint64_t(y);
+} //operator/
+
+/// Divide by a 32-bit unsigned integer.
+/// \param x Numerator.
+/// \param y Denominator.
+/// \return Floor of the numerator divided by the denominator.
+
+uintx_t operator/(const uintx_t& x, uint32_t y){
+  return x / uint64_t(y);
+} //operator/
+
+/// Remainder after division by a 64-bit unsigned integer. The numerator
+/// is not copied, and a divisor that fits into a single word takes a
+/// single pass with divrem_1().
+/// \param x Numerator.
+/// \param y Denominator.
+/// \return Remainder after the numerator is divided by the denominator.
+
+uintx_t operator%(const uintx_t& x, uint64_t y){
+  if(x.m_bNaN || y == 0)
+    return uintx_t::NaN;
+
+  if(y <= WORD_MAX) //single-word divisor
+    return uintx_t(divrem_1(nullptr, x.m_pData, x.m_nSize, word_t(y)));
+
+  if(x.m_nSize <= 2) //numerator fits into 64 bits
+    return uintx_t(to_uint64(x)%y);
+
+  const word_t w[2] = {word_t(y), word_t(y >> 32)}; //two 32-bit words
+  word_t r[2]; //remainder
+  divrem(nullptr, r, x.m_pData, x.m_nSize, w, 2);
+
+  return uintx_t(((uint64_t)r[1] << 32) | r[0]);
+} //operator%
+
+/// Remainder after division by a 32-bit integer. The result is NaN if
+/// the operand is negative.
+/// \param x Numerator.
+/// \param y Denominator.
+/// \return Remainder after the numerator is divided by the denominator.
+
+uintx_t operator%(const uintx_t& x, int32_t y){
+  return y < 0? uintx_t::NaN: x % uint64_t(y);
+} //operator%
+
+/// Remainder after division by a 64-bit integer. The result is NaN if
+/// the operand is negative.
+/// \param x Numerator.
+/// \param y Denominator.
+/// \return Remainder after the numerator is divided by the denominator.
+
+uintx_t operator%(const uintx_t& x, int64_t y){
+  return y < 0? uintx_t::NaN: x % uint64_t(y);
+} //operator%
+
+/// Remainder after division by a 32-bit unsigned integer.
+/// \param x Numerator.
+/// \param y Denominator.
+/// \return Remainder after the numerator is divided by the denominator.
+
+uintx_t operator%(const uintx_t& x, uint32_t y){
+  return x % uint64_t(y);
+} //operator%
+
+/// Remainder after division by a 64-bit unsigned integer.
+/// \param y Denominator.
+/// \return Reference after division by the denominator.
+
+uintx_t& uintx_t::operator%=(uint64_t y){
+  return *this = *this%y;
+} //operator%=
+
+/// Remainder after division by a 32-bit integer. The result is NaN if
+/// the operand is negative.
+/// \param y Operand.
+/// \return Reference after division by the denominator.
+
+uintx_t& uintx_t::operator%=(int32_t y){
+  return y < 0? *this = NaN: *this %= uint64_t(y);
+} //operator%=
+
+/// Remainder after division by a 64-bit integer. The result is NaN if
+/// the operand is negative.
+/// \param y Operand.
+/// \return Reference after division by the denominator.
+
+uintx_t& uintx_t::operator%=(int64_t y){
+  return y < 0? *this = NaN: *this %= uint64_t(y);
+} //operator%=
+
+/// Remainder after division by a 32-bit unsigned integer.
+/// \param y Operand.
+/// \return Reference after division by the denominator.
+
+uintx_t& uintx_t::operator%=(uint32_t y){
+  return *this %= uint64_t(y);
+} //operator%=
+
+/// Compute the quotient and the remainder with a single division, which is
+/// faster than using the division and remainder operators separately.
+/// Either result may be the same object as either operand, but the two
+/// results must be different objects. Both results are NaN if either
+/// operand is NaN or the denominator is zero.
+/// \param x Numerator.
+/// \param y Denominator.
+/// \param q [out] Floor of the numerator divided by the denominator.
+/// \param r [out] Remainder after the numerator is divided by the denominator.
+
+void divmodx(const uintx_t& x, const uintx_t& y, uintx_t& q, uintx_t& r){
+  if(x.m_bNaN || y.m_bNaN || y.is_zero()){
+    q = r = uintx_t::NaN;
+    return;
+  } //if
+
+  if(x < y){ //assign r first in case q is the same object as x
+    r = x;
+    q = 0;
+    return;
+  } //if
+
+  uintx_t quotient, remainder; //results, kept separate in case of aliasing
+  quotient.reallocate(x.m_nSize - y.m_nSize + 1); //enough space for the quotient
+  remainder.reallocate(y.m_nSize); //enough space for the remainder
+
+  divrem(quotient.m_pData, remainder.m_pData,
+    x.m_pData, x.m_nSize, y.m_pData, y.m_nSize);
+
+  quotient.normalize(); //remove leading zero words
+  remainder.normalize();
+
+  q = std::move(quotient);
+  r = std::move(remainder);
+} //divmodx
+
+/// Exact division, for a numerator that is known to be a multiple of the
+/// denominator, as in lcmx(). The trailing zero bits of the denominator
+/// are shifted out of both operands so that it is odd, and the quotient is
+/// then found from the least significant end by divexact(), which is
+/// faster than the division operator. The result is meaningless if the
+/// division is not exact.
+/// \param x Numerator, a multiple of the denominator.
+/// \param y Denominator.
+/// \return The numerator divided by the denominator, or NaN if either
+/// operand is NaN or the denominator is zero.
+
+uintx_t divexactx(const uintx_t& x, const uintx_t& y){
+  if(x.m_bNaN || y.m_bNaN || y.is_zero())
+    return uintx_t::NaN;
+
+  if(x < y)
+    return uintx_t(0);
+
+  uint32_t k = 0; //number of zero words at the bottom of y, and so of x
+  while(y.m_pData[k] == 0)k++;
+
+  const uint32_t d = ntz(y.m_pData[k]); //shift distance
+  uint32_t n = x.m_nSize - k; //number of words in shifted numerator
+  uint32_t m = y.m_nSize - k; //number of words in shifted denominator
+  word_t* a = new word_t[n + m]; //shifted numerator
+  word_t* b = a + n; //shifted denominator, which is odd
+
+  rshift(a, x.m_pData + k, n, d);
+  rshift(b, y.m_pData + k, m, d);
+  if(a[n - 1] == 0)n--; //at most one word is shifted out
+  if(b[m - 1] == 0)m--;
+
+  uintx_t q(0); //result
+
+  if(n >= m){ //always, unless the division is not exact
+    q.resize(n - m + 1);
+    divexact(q.m_pData, a, n, b, m);
+    q.normalize(); //remove leading zero words
+  } //if
+
+  delete [] a;
+  return q;
+} //divexactx
+
 #pragma endregion division
 
+/////////////////////////////////////////////////////////////////////////////
+// Greatest common divisor.
+
+#pragma region gcd
+
+/// Find the greatest common divisor of two extensible unsigned integers
+/// with gcd(), which uses Lehmer's algorithm, or the half-GCD algorithm
+/// for large operands, see uintx_gcd.cpp. Since gcd() reduces the operands
+/// in place, they are copied first into a single array, padded with zeros
+/// to the same length.
+/// \param x First operand.
+/// \param y Second operand.
+/// \return The greatest common divisor of the operands, or NaN if either
+/// is NaN.
+
+uintx_t gcdx(const uintx_t& x, const uintx_t& y){
+  if(x.m_bNaN || y.m_bNaN)
+    return uintx_t::NaN;
+
+  if(x.is_zero())return y;
+  if(y.is_zero())return x;
+
+  const uint32_t n = std::max(x.m_nSize, y.m_nSize); //words in operands
+  word_t* s = new word_t[2*n](); //copies of the operands, zeroed
+
+  std::copy(x.m_pData, x.m_pData + x.m_nSize, s);
+  std::copy(y.m_pData, y.m_pData + y.m_nSize, s + n);
+
+  uintx_t z; //result, no larger than the smaller operand
+  z.resize(std::min(x.m_nSize, y.m_nSize));
+  z.m_nSize = gcd(z.m_pData, s, s + n, n);
+
+  delete [] s;
+  return z;
+} //gcdx
+
+#pragma endregion gcd
+
 /////////////////////////////////////////////////////////////////////////////
 // Type conversions.
 
@@ -950,16 +2029,16 @@ uintx_t& uintx_t::operator%=(const uintx_t& y){
 const uint32_t to_uint32(const uintx_t& x){
   if(x.m_bNaN)return 0;
   else if(x.m_nSize <= 0)return 0;
-  else return x.m_pData[0];
+  else return uint32_t(x.m_pData[0]);
 } //to_uint32
 
-/// Convert to a 64-bit unsigned integer from the two least-significant words.
+/// Convert to a 64-bit unsigned integer from the least-significant words.
 /// \param x Operand.
 /// \return Least significant 64 bits of the operand.
 
 const uint64_t to_uint64(const uintx_t& x){
-  if(x.m_bNaN)return 0;
-  else if(x.m_nSize <= 1)return to_uint32(x);
+  if(x.m_bNaN || x.m_nSize <= 0)return 0;
+  else if(x.m_nSize <= 1 || WORDS_IN_UINT64 == 1)return uint64_t(x.m_pData[0]);
   return (uint64_t(x.m_pData[1]) << 32) | uint64_t(x.m_pData[0]);
 } //to_uint64
 
@@ -970,7 +2049,7 @@ const uint64_t to_uint64(const uintx_t& x){
 /// \return A float that is approximately equal to the operand.
 
 const float to_float(const uintx_t& x){
-  const float m = float(1LL << 32); //multiplier
+  const float m = std::ldexp(1.0f, BITS_IN_WORD); //multiplier
   float result = 0; //return result
 
   for(int32_t i=x.m_nSize-1; i>=0; i--)
@@ -986,7 +2065,7 @@ const float to_float(const uintx_t& x){
 /// \return A double that is approximately equal to the operand.
 
 const double to_double(const uintx_t& x){
-  const double m = double(1LL << 32); //multiplier
+  const double m = std::ldexp(1.0, BITS_IN_WORD); //multiplier
   double result = 0; //return result
 
   for(int32_t i=x.m_nSize-1; i>=0; i--)
@@ -999,89 +2078,364 @@ const double to_double(const uintx_t& x){
 /// \param x Operand.
 /// \return std::string containing the operand in binary notation.
 
-const std::string to_bitstring(const uintx_t& x){  
-  return to_string(x, 1);
+std::string to_bitstring(const uintx_t& x){  
+  return to_string(x, 2);
 } //to_bitstring
 
-/// Convert to a string in hex.
+/// Convert to a string in hex. The string is allocated once at its full
+/// length. The digits of the most significant word are written one at a
+/// time so that there are no leading zeros, and the rest are written two
+/// at a time from a table with an entry for each byte.
 /// \param x Operand.
 /// \return std::string containing the operand.
 
-const std::string to_hexstring(const uintx_t& x){  
+std::string to_hexstring(const uintx_t& x){  
   if(x.m_bNaN)return std::string("NaN");
 
-  std::string s; //result
+  const uint32_t top = x.m_nSize - 1; //index of most significant word
+  word_t w = x.m_pData[top]; //current word
+  uint32_t lead = 1; //number of digits in the most significant word
+  while(lead < NIBS_IN_WORD && (w >> 4*lead) > 0)lead++;
 
-  //convert to a backwards string, ie. least-significant digit first
+  std::string s(lead + size_t(top)*NIBS_IN_WORD, '0'); //result
+  char* p = &s[0]; //next digit
 
-  for(uint32_t i=0; i<x.m_nSize; i++){ //for each word, least significant first
-    uint32_t n = x.m_pData[i]; //current word
-    const uint32_t size = 2*sizeof(uint32_t); //number of digits in a word
+  for(uint32_t i=lead; i-->0;) //most significant word
+    *p++ = DIGITS[(w >> 4*i) & 0xF];
 
-    for(auto i=0; i<size; i++){ //for each digit, least-significant first
-      const uint32_t digit = n & 0xF; //grab a digit
-      const char c = char(digit + (digit < 10? '0': 'A' - 10)); //convert to char
-      s += c; //append to string
-      n >>= 4; //for next digit
-    } //while
+  for(uint32_t i=top; i-->0;){ //remaining words
+    w = x.m_pData[i];
+
+    for(uint32_t j=BYTES_IN_WORD; j-->0; p+=2) //for each byte, most significant first
+      std::memcpy(p, HEX_PAIRS + 2*((w >> 8*j) & 0xFF), 2); //its two digits
   } //for
 
-  //remove leading zeros, which are at the end
+  return s;
+} //to_hexstring
+
+/// Get the number of digits in a given base that fit into a word.
+/// \param base Base, at least 2.
+/// \param radix [out] Base to the power of the number of digits.
+/// \return Largest number of digits that fit into a word.
 
-  for(auto it=std::prev(s.end()); it!=s.begin() && *it=='0';){
-    --it; //prepare for next iteration
-    s.pop_back(); //remove leading zero
+static uint32_t digitsinword(uint32_t base, word_t& radix){
+  uint32_t d = 0; //number of digits
+  radix = 1;
+
+  while(radix <= WORD_MAX/base){
+    radix *= base;
+    d++;
   } //while
 
-  if(s == "")s = "0"; //safety
+  return d;
+} //digitsinword
+
+/// Get the value of a digit in bases up to 36. Letters stand for the
+/// digits from 10 to 35, and may be upper or lower case.
+/// \param c A character.
+/// \return Value of the digit, or 36 if the character is not a digit.
+
+static uint32_t digitvalue(char c){
+  if(c >= '0' && c <= '9')return c - '0';
+  if(c >= 'A' && c <= 'Z')return c - 'A' + 10;
+  if(c >= 'a' && c <= 'z')return c - 'a' + 10;
+  return 36;
+} //digitvalue
+
+/// Get a power of a base for splitting a number in string conversion.
+/// Entry k of the cache for a base \f$b\f$ is \f$r^{2^k}\f$, where
+/// \f$r = b^d\f$ is the largest power of the base that fits into a word,
+/// see digitsinword(). Each entry is the square of the one before and is
+/// computed the first time that it is needed. Entries of up to
+/// STRING_CACHE_WORDS words are kept for later conversions, so converting
+/// many large numbers pays for them only once. Each thread has its own
+/// cache, so that numbers may be converted on different threads at the
+/// same time. Larger entries are kept only for the current conversion, in
+/// a vector that the caller provides, so that converting a single huge
+/// number does not hold on to powers of half its size for the rest of the
+/// process.
+/// \param base Base, from 2 to 36.
+/// \param k Index of the power.
+/// \param big [in, out] Entries above the cached ones, for the current
+/// conversion only.
+/// \return The base to the power of \f$d2^k\f$.
+
+static const uintx_t& powerx(uint32_t base, uint32_t k,
+  std::vector<uintx_t>& big)
+{
+  static thread_local std::vector<uintx_t> powers[37]; //cache for each base
+  std::vector<uintx_t>& p = powers[base]; //cache for this base
+
+  if(p.empty()){
+    word_t radix; //largest power of the base that fits into a word
+    digitsinword(base, radix);
+    p.push_back(uintx_t(uint64_t(radix)));
+  } //if
 
-  //reverse the string to make it most significant digit first, and return
+  while(p.size() <= k && (size_t(1) << p.size()) <= STRING_CACHE_WORDS){ //entry k has at most 2^k words
+    const uintx_t& x = p.back(); //largest power so far
+    p.push_back(x*x);
+  } //while
 
-  std::reverse(s.begin(), s.end());
-  return s;
-} //to_hexstring
+  if(k < p.size())
+    return p[k];
+
+  if(big.empty())
+    big.push_back(p.back()*p.back());
+
+  while(p.size() + big.size() <= k){
+    const uintx_t& x = big.back(); //largest power so far
+    big.push_back(x*x);
+  } //while
+
+  return big[k - p.size()];
+} //powerx
+
+/// Write digits in a given base into a character buffer. The number must
+/// be smaller than the base to the power n, and is written as exactly n
+/// digits with leading zeros. Small numbers are divided by the largest
+/// power of the base that fits into a word with divrem_1() to peel off a
+/// word of digits at a time from the least significant end. Larger numbers
+/// are split into two halves by dividing by a cached power of the base from
+/// powerx() with \f$d2^k\f$ digits, where this is the largest such number
+/// less than n, which is at least half of them. The halves are converted
+/// recursively, the remainder being padded with leading zeros. This is
+/// much faster than peeling digits off the whole number, and gets faster
+/// still with faster division.
+/// \param s [out] Buffer for n characters.
+/// \param n Number of digits.
+/// \param base Base, from 2 to 36.
+/// \param big [in, out] Powers of the base too large for the cache, see
+/// powerx().
+
+void uintx_t::todigits(char* s, size_t n, uint32_t base,
+  std::vector<uintx_t>& big) const
+{
+  word_t radix; //largest power of the base that fits into a word
+  const uint32_t d = digitsinword(base, radix); //number of digits in radix
+
+  if(m_nSize <= STRING_THRESHOLD){ //a word of digits at a time
+    word_t t[STRING_THRESHOLD]; //copy of the number
+    uint32_t size = m_nSize; //number of words left in t
+    std::copy(m_pData, m_pData + size, t);
+    char* p = s + n; //one past the next digit, working backwards
+
+    while(size > 0 && p > s){
+      word_t w = divrem_1(t, t, size, radix); //next word of digits
+      if(t[size - 1] == 0)size--;
+
+      for(uint32_t i=0; i<d && p > s; i++){
+        *--p = DIGITS[w%base];
+        w /= base;
+      } //for
+    } //while
+
+    std::fill(s, p, '0'); //leading zeros
+  } //if
+
+  else{ //divide and conquer
+    uint32_t k = 0; //index of the power of the base to split by
+
+    while((size_t(d) << (k + 1)) < n)
+      k++;
 
-/// Convert to a decimal string.
+    const size_t m = size_t(d) << k; //number of digits in the bottom half
+    uintx_t q, r; //top and bottom halves
+
+    divmodx(*this, powerx(base, k, big), q, r);
+    q.todigits(s, n - m, base, big);
+    r.todigits(s + n - m, m, base, big);
+  } //else
+} //todigits
+
+/// Set to the value of a string of digits in a given base, which must all
+/// be valid. Short strings are read a word of digits at a time, each time
+/// multiplying what has been read so far by the largest power of the base
+/// that fits into a word and adding the new word. Longer strings are split
+/// into two parts by the position that leaves \f$d2^k\f$ digits in the
+/// bottom part, where this is the largest such number less than n. The two
+/// parts are read recursively and combined by multiplying the top part by a
+/// cached power of the base from powerx() and adding the bottom part. This
+/// makes reading a long string as fast as multiplying its halves.
+/// \param s Digits, most significant first.
+/// \param n Number of digits, at least one.
+/// \param base Base, from 2 to 36.
+/// \param big [in, out] Powers of the base too large for the cache, see
+/// powerx().
+
+void uintx_t::fromdigits(const char* s, size_t n, uint32_t base,
+  std::vector<uintx_t>& big)
+{
+  word_t radix; //largest power of the base that fits into a word
+  const uint32_t d = digitsinword(base, radix); //number of digits in radix
+
+  if(n <= size_t(STRING_THRESHOLD)*d){ //a word of digits at a time
+    reallocate(uint32_t(n/d) + 2); //enough space, cleared
+    uint32_t size = 1; //number of words read so far
+
+    for(size_t i=0; i<n;){
+      const size_t len = i == 0 && n%d > 0? n%d: d; //number of digits in next word
+      word_t w = 0; //next word
+      word_t scale = 1; //base to the power len
+
+      for(size_t j=0; j<len; j++, i++){
+        w = w*base + digitvalue(s[i]);
+        scale *= base;
+      } //for
+
+      word_t carry = mul_1(m_pData, m_pData, size, scale); //make room
+      if(carry > 0)m_pData[size++] = carry;
+      carry = add(m_pData, m_pData, size, &w, 1); //add the word
+      if(carry > 0)m_pData[size++] = carry;
+    } //for
+
+    m_nSize = size;
+    normalize(); //remove leading zero words
+  } //if
+
+  else{ //divide and conquer
+    uint32_t k = 0; //index of the power of the base to split by
+
+    while((size_t(d) << (k + 1)) < n)
+      k++;
+
+    const size_t m = size_t(d) << k; //number of digits in the bottom part
+    uintx_t bottom; //bottom part
+
+    fromdigits(s, n - m, base, big);
+    bottom.fromdigits(s + n - m, m, base, big);
+    *this *= powerx(base, k, big);
+    *this += bottom;
+  } //else
+} //fromdigits
+
+/// Convert to a string in a given base from 2 to 36. The digits are 0 to
+/// 9 followed by the upper case letters A to Z. The string is allocated
+/// once at its full length and the digits are written straight into it.
+/// In a base that is a power of two each digit is a fixed number of bits,
+/// which are picked out of the words in a single pass. Other bases are
+/// converted by todigits(), which divides and conquers using cached powers
+/// of the base, into a string with room for the largest number of digits
+/// that the operand can have, after which any leading zeros are removed.
 /// \param x Operand.
-/// \param base Base, assumed to be at most 10.
-/// \return std::string containing the operand in decimal notation.
+/// \param base Base.
+/// \return std::string containing the operand in the base, "NaN" if the
+/// operand is NaN, or an empty string if the base is out of range.
 
-const std::string to_string(const uintx_t& x, const uint32_t base){  
+std::string to_string(const uintx_t& x, const uint32_t base){  
   if(x.m_bNaN)return std::string("NaN");
+  if(base < 2 || base > 36)return std::string();
+
+  const size_t bits = log2x(x) + 1; //number of bits
   std::string s; //result
 
-  if(x == 0)
-    s = "0";
+  if((base & (base - 1)) == 0){ //power of two
+    uint32_t b = 0; //number of bits in a digit
+    while((1U << b) < base)b++;
 
-  else{
-    uintx_t y(x);
+    const size_t n = (bits + b - 1)/b; //number of digits
+    s.resize(n);
 
-    while(y > 0){
-      const uint32_t digit = to_uint32(y%base);
-      const char c = char(digit + '0');
-      s += c;
-      y /= base;
-    } //while
+    for(size_t i=0; i<n; i++){ //for each digit, least significant first
+      const size_t pos = i*b; //position of its least significant bit
+      const uint32_t j = uint32_t(pos/BITS_IN_WORD); //word containing it
+      const uint32_t shift = pos%BITS_IN_WORD; //position within the word
+      word_t w = x.m_pData[j] >> shift; //digit, perhaps with more bits
+
+      if(shift + b > BITS_IN_WORD && j + 1 < x.m_nSize) //straddles two words
+        w |= x.m_pData[j + 1] << (BITS_IN_WORD - shift);
+
+      s[n - 1 - i] = DIGITS[w & (base - 1)];
+    } //for
+  } //if
+
+  else{
+    const double digits = bits*std::log(2.0)/std::log(double(base)); //approximately
+    s.assign(size_t(digits*(1 + 1e-9)) + 1, '0'); //slightly more than enough
+    std::vector<uintx_t> big; //powers of the base too large to cache
+    x.todigits(&s[0], s.size(), base, big);
+    s.erase(0, std::min(s.find_first_not_of('0'), s.size() - 1)); //remove leading zeros
   } //else
-  
-  std::reverse(s.begin(), s.end());
+
   return s;
 } //to_string
 
-/// Convert to a comma-separated decimal string.
+/// Convert to a comma-separated decimal string. The commas are put in
+/// while copying the digits into a string of the final length.
 /// \param x Operand.
 /// \return std::string containing the operand in decimal notation with commas.
 
-const std::string to_commastring(const uintx_t& x){  
+std::string to_commastring(const uintx_t& x){  
   if(x.m_bNaN)return std::string("NaN");
 
-  std::string s = to_string(x, 10UL); //result
-  const int32_t n = (int32_t)s.length() - 3; //position of first comma
+  const std::string digits = to_string(x, 10UL); //without commas
+  const size_t n = digits.length(); //number of digits
+  std::string s; //result
+  s.reserve(n + (n - 1)/3);
 
-  for(int32_t i=n; i>0; i-=3) //every third character
-    s.insert(i, ","); //insert a comma
+  for(size_t i=0; i<n; i++){ //for each digit
+    if(i > 0 && (n - i)%3 == 0)
+      s += ','; //comma before every third digit from the right
+    s += digits[i];
+  } //for
 
   return s;
 } //to_commastring
 
+/// Convert from a string in a given base from 2 to 36. The digits are
+/// 0 to 9 followed by the letters A to Z, in upper or lower case, and the
+/// most significant digit comes first. The result is NaN if the base is
+/// out of range, the string is empty, or it contains a character that is
+/// not a digit in the base. In a base that is a power of two each digit is
+/// a fixed number of bits, which are packed straight into words in a single
+/// pass. Other bases are converted by fromdigits(), which is subquadratic.
+/// \param s A string of digits.
+/// \param base Base.
+/// \return The value of the string.
+
+uintx_t from_string(const std::string& s, const uint32_t base){  
+  if(base < 2 || base > 36 || s.empty())
+    return uintx_t::NaN;
+
+  for(const char c: s)
+    if(digitvalue(c) >= base)
+      return uintx_t::NaN;
+
+  uintx_t result; //return result
+
+  if((base & (base - 1)) == 0){ //power of two
+    uint32_t bits = 0; //number of bits in a digit
+    while((1U << bits) < base)bits++;
+
+    const size_t size = (s.size()*bits + BITS_IN_WORD - 1)/BITS_IN_WORD;
+    result.reallocate(uint32_t(size)); //enough space, cleared
+    dword_t t = 0; //bits not yet stored
+    uint32_t tbits = 0; //number of bits in t
+    uint32_t i = 0; //index of next word
+
+    for(auto it=s.rbegin(); it!=s.rend(); it++){ //least significant first
+      t |= dword_t(digitvalue(*it)) << tbits;
+      tbits += bits;
+
+      if(tbits >= BITS_IN_WORD){ //a word is full
+        result.m_pData[i++] = word_t(t);
+        t >>= BITS_IN_WORD;
+        tbits -= BITS_IN_WORD;
+      } //if
+    } //for
+
+    if(tbits > 0)
+      result.m_pData[i] = word_t(t);
+
+    result.normalize(); //remove leading zero words
+  } //if
+
+  else{
+    std::vector<uintx_t> big; //powers of the base too large to cache
+    result.fromdigits(s.data(), s.size(), base, big);
+  } //else
+
+  return result;
+} //from_string
+
 #pragma endregion conversions
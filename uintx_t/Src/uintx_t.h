@@ -5,31 +5,61 @@
 #define __uintx_t__
 
 #include <string>
+#include <vector>
+
+#include "uintx_word.h"
 
 /// \brief The extensible unsigned integer class.
 ///
 /// Extensible unsigned integers store very large numbers as an array of
-/// 32-bit words, least-significant first. Precision is limited by the amount
-/// of memory that can be allocated, potentially up to
-/// \f$2^{32} = 4,294,967,296\f$ 32-bit words, that is, 
-/// \f$2^{37} = 137,438,953,472\f$ bits. All non-zero extensible unsigned
+/// 32-bit words, least-significant first, or 64-bit words if the library is
+/// compiled with `UINTX_WORD64` defined (see uintx_word.h). Precision is
+/// limited by the amount of memory that can be allocated, potentially up to
+/// \f$2^{32} = 4,294,967,296\f$ words, that is, 
+/// \f$2^{37} = 137,438,953,472\f$ bits for 32-bit words. All non-zero extensible unsigned
 /// integers have a non-zero most-significant word. The amount of storage used
 /// adjusts automatically. Any function or operation that results in a
 /// negative number will return NaN (Not a Number), as will division by zero
 /// and any function or operation that acts on NaN.
+///
+/// The arithmetic operators also take built-in integer operands directly,
+/// which is much faster than converting them to extensible unsigned
+/// integers first. Negative built-in operands give NaN.
+///
+/// Values of up to 128 bits are stored in a small buffer inside the object
+/// itself, so that small extensible unsigned integers can be created,
+/// copied, and operated on without touching the heap. Larger values spill
+/// over into heap storage. Heap storage grows geometrically and is not
+/// given back when a value shrinks, so that values which are repeatedly
+/// updated in place, such as accumulators, rarely need to reallocate.
+/// Use reserve() to allocate space ahead of time and shrink_to_fit() to
+/// give back unused space.
 
 class uintx_t{ 
   private:
-    uint32_t* m_pData = nullptr; ///< Array of 32-bit words.
+    static const uint32_t LOCAL_SIZE = 16/sizeof(word_t); ///< Number of words in m_pLocal.
+
+    word_t m_pLocal[LOCAL_SIZE]; ///< Local storage for small values.
+    word_t* m_pData = m_pLocal; ///< Array of words.
     uint32_t m_nSize = 0; ///< Number of significant words in m_pData.
+    uint32_t m_nCapacity = LOCAL_SIZE; ///< Number of words allocated for m_pData.
 
     bool m_bNaN = false; ///< Not a number.
 
+    word_t* allocate(const uint32_t); ///< Allocate space.
+    void release(word_t*); ///< Release space.
+    void recapacity(const uint32_t); ///< Change capacity.
     void loadstring(const std::string&); ///< Load hex string.
+    void todigits(char*, size_t, uint32_t, std::vector<uintx_t>&) const; ///< Write digits.
+    void fromdigits(const char*, size_t, uint32_t, std::vector<uintx_t>&); ///< Read digits.
     void reallocate(const uint32_t); ///< Reallocate space.
+    void resize(const uint32_t); ///< Resize without keeping the value.
     void grow(const uint32_t); ///< Grow space.
     void normalize(); ///< Remove leading zero words.
 
+    friend class uintx_divisor; ///< Prepared divisor.
+    friend class uintx_montgomery; ///< Montgomery context.
+
   public:
     uintx_t(); ///< Constructor.
     uintx_t(int32_t); ///< Constructor.
@@ -39,12 +69,20 @@ class uintx_t{
     uintx_t(const std::string&); ///< Constructor.
     uintx_t(const char*); ///< Constructor.
     uintx_t(const uintx_t&); ///< Copy constructor.
+    uintx_t(uintx_t&&); ///< Move constructor.
 
     ~uintx_t(); ///< Destructor
 
+    //storage
+
+    void reserve(const uint32_t); ///< Reserve space.
+    void shrink_to_fit(); ///< Release unused space.
+    uint32_t capacity() const; ///< Get capacity.
+
     //assignment operator
 
     uintx_t& operator=(const uintx_t&); ///< Assignment.
+    uintx_t& operator=(uintx_t&&); ///< Move assignment.
 
     //increment and decrement operators
 
@@ -57,65 +95,162 @@ class uintx_t{
     //addition operators
 
     uintx_t& operator+=(const uintx_t&); ///< Add to.
-    friend const uintx_t operator+(const uintx_t&, const uintx_t&); ///< Addition.
+    uintx_t& operator+=(int32_t); ///< Add to.
+    uintx_t& operator+=(int64_t); ///< Add to.
+    uintx_t& operator+=(uint32_t); ///< Add to.
+    uintx_t& operator+=(uint64_t); ///< Add to.
+
+    friend uintx_t operator+(const uintx_t&, const uintx_t&); ///< Addition.
+    friend uintx_t operator+(const uintx_t&, int32_t); ///< Addition.
+    friend uintx_t operator+(const uintx_t&, int64_t); ///< Addition.
+    friend uintx_t operator+(const uintx_t&, uint32_t); ///< Addition.
+    friend uintx_t operator+(const uintx_t&, uint64_t); ///< Addition.
+    friend uintx_t operator+(int32_t, const uintx_t&); ///< Addition.
+    friend uintx_t operator+(int64_t, const uintx_t&); ///< Addition.
+    friend uintx_t operator+(uint32_t, const uintx_t&); ///< Addition.
+    friend uintx_t operator+(uint64_t, const uintx_t&); ///< Addition.
 
     //subtraction operators
     
     uintx_t& operator-=(const uintx_t&); ///< Subtract from.
-    friend const uintx_t operator-(const uintx_t&, const uintx_t&); ///< Subtraction.
+    uintx_t& operator-=(int32_t); ///< Subtract from.
+    uintx_t& operator-=(int64_t); ///< Subtract from.
+    uintx_t& operator-=(uint32_t); ///< Subtract from.
+    uintx_t& operator-=(uint64_t); ///< Subtract from.
+
+    friend uintx_t operator-(const uintx_t&, const uintx_t&); ///< Subtraction.
+    friend uintx_t operator-(const uintx_t&, int32_t); ///< Subtraction.
+    friend uintx_t operator-(const uintx_t&, int64_t); ///< Subtraction.
+    friend uintx_t operator-(const uintx_t&, uint32_t); ///< Subtraction.
+    friend uintx_t operator-(const uintx_t&, uint64_t); ///< Subtraction.
 
     //multiplication operators
 
     uintx_t& operator*=(const uintx_t&); ///< Multiply by.
-    friend const uintx_t operator*(const uintx_t&, const uintx_t&); ///< Multiplication.
+    uintx_t& operator*=(int32_t); ///< Multiply by.
+    uintx_t& operator*=(int64_t); ///< Multiply by.
+    uintx_t& operator*=(uint32_t); ///< Multiply by.
+    uintx_t& operator*=(uint64_t); ///< Multiply by.
+
+    friend uintx_t operator*(const uintx_t&, const uintx_t&); ///< Multiplication.
+    friend uintx_t operator*(const uintx_t&, int32_t); ///< Multiplication.
+    friend uintx_t operator*(const uintx_t&, int64_t); ///< Multiplication.
+    friend uintx_t operator*(const uintx_t&, uint32_t); ///< Multiplication.
+    friend uintx_t operator*(const uintx_t&, uint64_t); ///< Multiplication.
+    friend uintx_t operator*(int32_t, const uintx_t&); ///< Multiplication.
+    friend uintx_t operator*(int64_t, const uintx_t&); ///< Multiplication.
+    friend uintx_t operator*(uint32_t, const uintx_t&); ///< Multiplication.
+    friend uintx_t operator*(uint64_t, const uintx_t&); ///< Multiplication.
 
     //division operators
 
     uintx_t& operator/=(const uintx_t&); ///< Divide by.
-    friend const uintx_t operator/(const uintx_t&, const uintx_t&); ///< Division.
+    uintx_t& operator/=(int32_t); ///< Divide by.
+    uintx_t& operator/=(int64_t); ///< Divide by.
+    uintx_t& operator/=(uint32_t); ///< Divide by.
+    uintx_t& operator/=(uint64_t); ///< Divide by.
+
+    friend uintx_t operator/(const uintx_t&, const uintx_t&); ///< Division.
+    friend uintx_t operator/(const uintx_t&, int32_t); ///< Division.
+    friend uintx_t operator/(const uintx_t&, int64_t); ///< Division.
+    friend uintx_t operator/(const uintx_t&, uint32_t); ///< Division.
+    friend uintx_t operator/(const uintx_t&, uint64_t); ///< Division.
 
     uintx_t& operator%=(const uintx_t&); ///< Remainder.
-    friend const uintx_t operator%(const uintx_t&, const uintx_t&); ///< Remainder.
+    uintx_t& operator%=(int32_t); ///< Remainder.
+    uintx_t& operator%=(int64_t); ///< Remainder.
+    uintx_t& operator%=(uint32_t); ///< Remainder.
+    uintx_t& operator%=(uint64_t); ///< Remainder.
+
+    friend uintx_t operator%(const uintx_t&, const uintx_t&); ///< Remainder.
+    friend uintx_t operator%(const uintx_t&, int32_t); ///< Remainder.
+    friend uintx_t operator%(const uintx_t&, int64_t); ///< Remainder.
+    friend uintx_t operator%(const uintx_t&, uint32_t); ///< Remainder.
+    friend uintx_t operator%(const uintx_t&, uint64_t); ///< Remainder.
+
+    friend void divmodx(const uintx_t&, const uintx_t&, uintx_t&, uintx_t&); ///< Quotient and remainder.
+    friend uintx_t divexactx(const uintx_t&, const uintx_t&); ///< Exact division.
+    friend uintx_t gcdx(const uintx_t&, const uintx_t&); ///< Greatest common divisor.
 
     //comparison operators
 
+    friend const int32_t compare(const uintx_t&, const uintx_t&); ///< Three-way comparison.
+    friend const int32_t compare(const uintx_t&, int32_t); ///< Three-way comparison.
+    friend const int32_t compare(const uintx_t&, int64_t); ///< Three-way comparison.
+    friend const int32_t compare(const uintx_t&, uint32_t); ///< Three-way comparison.
+    friend const int32_t compare(const uintx_t&, uint64_t); ///< Three-way comparison.
+
     friend const bool operator>(const uintx_t&, const uintx_t&); ///< Greater than.
+    friend const bool operator>(const uintx_t&, int32_t); ///< Greater than.
+    friend const bool operator>(const uintx_t&, int64_t); ///< Greater than.
+    friend const bool operator>(const uintx_t&, uint32_t); ///< Greater than.
+    friend const bool operator>(const uintx_t&, uint64_t); ///< Greater than.
+
     friend const bool operator>=(const uintx_t&, const uintx_t&); ///< Greater than or equal.
+    friend const bool operator>=(const uintx_t&, int32_t); ///< Greater than or equal.
+    friend const bool operator>=(const uintx_t&, int64_t); ///< Greater than or equal.
+    friend const bool operator>=(const uintx_t&, uint32_t); ///< Greater than or equal.
+    friend const bool operator>=(const uintx_t&, uint64_t); ///< Greater than or equal.
+
     friend const bool operator<(const uintx_t&, const uintx_t&); ///< Less than.
+    friend const bool operator<(const uintx_t&, int32_t); ///< Less than.
+    friend const bool operator<(const uintx_t&, int64_t); ///< Less than.
+    friend const bool operator<(const uintx_t&, uint32_t); ///< Less than.
+    friend const bool operator<(const uintx_t&, uint64_t); ///< Less than.
+
     friend const bool operator<=(const uintx_t&, const uintx_t&); ///< Less than or equal.
+    friend const bool operator<=(const uintx_t&, int32_t); ///< Less than or equal.
+    friend const bool operator<=(const uintx_t&, int64_t); ///< Less than or equal.
+    friend const bool operator<=(const uintx_t&, uint32_t); ///< Less than or equal.
+    friend const bool operator<=(const uintx_t&, uint64_t); ///< Less than or equal.
+
     friend const bool operator==(const uintx_t&, const uintx_t&); ///< Equal to.
+    friend const bool operator==(const uintx_t&, int32_t); ///< Equal to.
+    friend const bool operator==(const uintx_t&, int64_t); ///< Equal to.
+    friend const bool operator==(const uintx_t&, uint32_t); ///< Equal to.
+    friend const bool operator==(const uintx_t&, uint64_t); ///< Equal to.
+
     friend const bool operator!=(const uintx_t&, const uintx_t&); ///< Not equal to.
+    friend const bool operator!=(const uintx_t&, int32_t); ///< Not equal to.
+    friend const bool operator!=(const uintx_t&, int64_t); ///< Not equal to.
+    friend const bool operator!=(const uintx_t&, uint32_t); ///< Not equal to.
+    friend const bool operator!=(const uintx_t&, uint64_t); ///< Not equal to.
 
     //bit shift operators
 
     uintx_t& operator<<=(const int32_t); ///< Left shift by.
-    friend const uintx_t operator<<(const uintx_t&, int32_t); ///< Left shift.
+    friend uintx_t operator<<(const uintx_t&, int32_t); ///< Left shift.
+    friend void lshiftx(const uintx_t&, int32_t, uintx_t&); ///< Left shift into.
 
     uintx_t& operator>>=(int32_t); ///< Right shift by.
-    friend const uintx_t operator>>(const uintx_t&, int32_t); ///< Right shift.
+    friend uintx_t operator>>(const uintx_t&, int32_t); ///< Right shift.
+    friend void rshiftx(const uintx_t&, int32_t, uintx_t&); ///< Right shift into.
 
     //bitwise operators
     
     uintx_t& operator&=(const uintx_t&); ///< Bit-wise AND.
-    friend const uintx_t operator&(const uintx_t&, const uintx_t&); ///< Bit-wise AND.
+    friend uintx_t operator&(const uintx_t&, const uintx_t&); ///< Bit-wise AND.
     
     uintx_t& operator|=(const uintx_t&); ///< Bit-wise OR.
-    friend const uintx_t operator|(const uintx_t&, const uintx_t&); ///< Bit-wise OR.
+    friend uintx_t operator|(const uintx_t&, const uintx_t&); ///< Bit-wise OR.
     
     uintx_t& operator^=(const uintx_t&); ///< Bit-wise XOR.
-    friend const uintx_t operator^(const uintx_t&, const uintx_t&); ///< Bit-wise XOR.
+    friend uintx_t operator^(const uintx_t&, const uintx_t&); ///< Bit-wise XOR.
 
-    friend const uintx_t operator~(const uintx_t&); ///< Bit-wise negation.
+    friend uintx_t operator~(const uintx_t&); ///< Bit-wise negation.
 
     //miscellaneous
 
+    bool is_zero() const; ///< Zero test.
     friend const uint32_t log2x(const uintx_t&); ///< Floor of log base 2.
 
     //type conversions
     
-    friend const std::string to_hexstring(const uintx_t&); ///< To hex string.
-    friend const std::string to_string(const uintx_t&, const uint32_t); ///<To string.
-    friend const std::string to_commastring(const uintx_t&); ///<To comma separated string.
+    friend std::string to_bitstring(const uintx_t&); ///< To binary string.
+    friend std::string to_hexstring(const uintx_t&); ///< To hex string.
+    friend std::string to_string(const uintx_t&, const uint32_t); ///<To string.
+    friend std::string to_commastring(const uintx_t&); ///<To comma separated string.
+    friend uintx_t from_string(const std::string&, const uint32_t); ///< From string.
 
     friend const uint32_t to_uint32(const uintx_t&); ///< To 32-bit unsigned int.
     friend const uint64_t to_uint64(const uintx_t&); ///< To 64-bit unsigned int.
@@ -127,4 +262,7 @@ class uintx_t{
     static const uintx_t NaN; ///< Not a number.
 }; //uintx_t
 
+std::string to_string(const uintx_t&, const uint32_t=10); ///<To string.
+uintx_t from_string(const std::string&, const uint32_t=10); ///< From string.
+
 #endif
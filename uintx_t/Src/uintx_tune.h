@@ -0,0 +1,75 @@
+/// \file uintx_tune.h
+/// \brief Declaration of the tunable algorithm thresholds.
+///
+/// The extensible unsigned integer operators switch to asymptotically faster
+/// algorithms once their operands are large enough for the extra bookkeeping
+/// to pay off. The crossover points depend on the host, so they are kept in
+/// global variables that may be changed at run time. Their initial values
+/// may be overridden at compile time by defining the corresponding macros.
+/// The `tune` program measures the crossover points on the host and writes
+/// them to a header file `uintx_thresholds.h`. Copy that file into the
+/// same folder as this one and compile the library with `UINTX_TUNED`
+/// defined to use them.
+///
+/// On x64 some of the word-array kernels also have versions that use newer
+/// instruction sets (ADX, AVX2, and AVX-512). The best one that the host
+/// supports is chosen at startup. A particular variant can be forced by
+/// setting the environment variable `UINTX_KERNELS` to its name, or by
+/// calling set_kernels(), for example to check that they all agree.
+
+#if !defined(__uintx_tune__)
+#define __uintx_tune__
+
+#include <cstdint>
+
+#if defined(UINTX_TUNED)
+  #include "uintx_thresholds.h"
+#endif
+
+#if !defined(UINTX_KARATSUBA_THRESHOLD)
+  #define UINTX_KARATSUBA_THRESHOLD 28 ///< Default Karatsuba threshold.
+#endif
+
+#if !defined(UINTX_TOOM3_THRESHOLD)
+  #define UINTX_TOOM3_THRESHOLD 224 ///< Default Toom-3 threshold.
+#endif
+
+#if !defined(UINTX_NTT_THRESHOLD)
+  #define UINTX_NTT_THRESHOLD 16384 ///< Default NTT threshold.
+#endif
+
+#if !defined(UINTX_SQR_KARATSUBA_THRESHOLD)
+  #define UINTX_SQR_KARATSUBA_THRESHOLD 48 ///< Default Karatsuba squaring threshold.
+#endif
+
+#if !defined(UINTX_SQR_TOOM3_THRESHOLD)
+  #define UINTX_SQR_TOOM3_THRESHOLD 280 ///< Default Toom-3 squaring threshold.
+#endif
+
+#if !defined(UINTX_SQR_NTT_THRESHOLD)
+  #define UINTX_SQR_NTT_THRESHOLD 16384 ///< Default NTT squaring threshold.
+#endif
+
+#if !defined(UINTX_BZ_THRESHOLD)
+  #define UINTX_BZ_THRESHOLD 48 ///< Default Burnikel-Ziegler division threshold.
+#endif
+
+#if !defined(UINTX_GCD_THRESHOLD)
+  #define UINTX_GCD_THRESHOLD 100 ///< Default half-GCD threshold.
+#endif
+
+extern uint32_t g_nKaratsubaThreshold; ///< Words at which Karatsuba multiplication starts.
+extern uint32_t g_nToom3Threshold; ///< Words at which Toom-3 multiplication starts.
+extern uint32_t g_nNTTThreshold; ///< Words at which NTT multiplication starts.
+
+extern uint32_t g_nSqrKaratsubaThreshold; ///< Words at which Karatsuba squaring starts.
+extern uint32_t g_nSqrToom3Threshold; ///< Words at which Toom-3 squaring starts.
+extern uint32_t g_nSqrNTTThreshold; ///< Words at which NTT squaring starts.
+
+extern uint32_t g_nBZThreshold; ///< Words at which Burnikel-Ziegler division starts.
+extern uint32_t g_nGCDThreshold; ///< Words at which the half-GCD algorithm starts.
+
+const char* get_kernels(); ///< Name of the kernel variant in use.
+bool set_kernels(const char*); ///< Select a kernel variant by name.
+
+#endif
@@ -0,0 +1,32 @@
+/// \file uintx_word.h
+/// \brief Declaration of the word types.
+///
+/// Extensible unsigned integers are stored as arrays of words. By default
+/// a word has 32 bits and products of words are computed in 64 bits, which
+/// works with any compiler. Defining `UINTX_WORD64` when compiling the
+/// library and everything that uses it makes a word 64 bits instead, with
+/// products computed in `unsigned __int128`. That halves the number of
+/// words to loop over and makes each word product do four times as much
+/// work on 64-bit hosts. The public interface and the results are the same
+/// either way, but the sizes passed to reserve() and returned by capacity()
+/// are in words. This option needs a compiler that supports
+/// `unsigned __int128`, such as g++ or clang on a 64-bit target.
+
+#if !defined(__uintx_word__)
+#define __uintx_word__
+
+#include <cstdint>
+
+#if defined(UINTX_WORD64)
+  #if !defined(__SIZEOF_INT128__)
+    #error UINTX_WORD64 needs a compiler that supports unsigned __int128
+  #endif
+
+  typedef uint64_t word_t; ///< A word.
+  typedef unsigned __int128 dword_t; ///< A double word.
+#else
+  typedef uint32_t word_t; ///< A word.
+  typedef uint64_t dword_t; ///< A double word.
+#endif
+
+#endif